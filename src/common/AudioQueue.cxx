@@ -17,46 +17,51 @@
 
 #include "AudioQueue.hxx"
 
-using std::mutex;
-using std::lock_guard;
+using std::memory_order_relaxed;
+using std::memory_order_acquire;
+using std::memory_order_release;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 AudioQueue::AudioQueue(uInt32 fragmentSize, uInt32 capacity, bool isStereo)
   : myFragmentSize{fragmentSize},
     myIsStereo{isStereo},
-    myFragmentQueue{capacity},
-    myAllFragments{capacity + 2}
+    myCapacity{capacity},
+    myFragmentQueue{capacity * 2},
+    myAllFragments{capacity * 2 + 2}
 {
   const uInt8 sampleSize = myIsStereo ? 2 : 1;
+  const uInt32 slots = capacity * 2;
 
   myFragmentBuffer = make_unique<Int16[]>(
-      static_cast<size_t>(myFragmentSize) * sampleSize * (capacity + 2));
+      static_cast<size_t>(myFragmentSize) * sampleSize * (slots + 2));
 
-  for (uInt32 i = 0; i < capacity; ++i)
+  for (uInt32 i = 0; i < slots; ++i)
     myFragmentQueue[i] = myAllFragments[i] = myFragmentBuffer.get() +
       static_cast<size_t>(myFragmentSize) * sampleSize * i;
 
-  myAllFragments[capacity] = myFirstFragmentForEnqueue =
+  myAllFragments[slots] = myFirstFragmentForEnqueue =
     myFragmentBuffer.get() + static_cast<size_t>(myFragmentSize) * sampleSize *
-    capacity;
+    slots;
 
-  myAllFragments[capacity + 1] = myFirstFragmentForDequeue =
+  myAllFragments[slots + 1] = myFirstFragmentForDequeue =
     myFragmentBuffer.get() + static_cast<size_t>(myFragmentSize) * sampleSize *
-    (capacity + 1);
+    (slots + 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 AudioQueue::capacity() const
 {
-  return static_cast<uInt32>(myFragmentQueue.size());
+  return myCapacity;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 AudioQueue::size() const
 {
-  const lock_guard<mutex> guard(myMutex);
+  // Load the read index first; this way, the difference can't become negative
+  const uInt64 readIndex = myReadIndex.load(memory_order_acquire);
+  const uInt64 size = myWriteIndex.load(memory_order_acquire) - readIndex;
 
-  return mySize;
+  return static_cast<uInt32>(std::min<uInt64>(size, myCapacity));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -74,40 +79,57 @@ uInt32 AudioQueue::fragmentSize() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Int16* AudioQueue::enqueue(Int16* fragment)
 {
-  const lock_guard<mutex> guard(myMutex);
-
-  Int16* newFragment = nullptr;
-
   if (!fragment) {
     if (!myFirstFragmentForEnqueue) throw runtime_error("enqueue called empty");
 
-    newFragment = myFirstFragmentForEnqueue;
+    Int16* newFragment = myFirstFragmentForEnqueue;
     myFirstFragmentForEnqueue = nullptr;
 
     return newFragment;
   }
 
-  const auto capacity = static_cast<uInt8>(myFragmentQueue.size());
-  const uInt8 fragmentIndex = (myNextFragment + mySize) % capacity;
+  const uInt64 slots = myFragmentQueue.size();
+  const uInt64 writeIndex = myWriteIndex.load(memory_order_relaxed);
+
+  // Acquire the slots that the consumer has released
+  const uInt64 queued = writeIndex - myReadIndex.load(memory_order_acquire);
 
-  newFragment = myFragmentQueue.at(fragmentIndex);
-  myFragmentQueue.at(fragmentIndex) = fragment;
+  if (queued >= myCapacity) {
+    // The queue is full -> the oldest fragment is dropped by the consumer,
+    // or, if it has stalled and the ring is full, the new one right here
+    myOverflowCount.fetch_add(1, memory_order_relaxed);
+    if (!myIgnoreOverflows.load(memory_order_relaxed)) myOverflowLogger.log();
 
-  if (mySize < capacity) ++mySize;
-  else {
-    myNextFragment = (myNextFragment + 1) % capacity;
-    if (!myIgnoreOverflows) myOverflowLogger.log();
+    if (queued >= slots) return fragment;
   }
 
+  Int16*& slot = myFragmentQueue[writeIndex % slots];
+  Int16* newFragment = slot;
+  slot = fragment;
+
+  // Publish the fragment to the consumer
+  myWriteIndex.store(writeIndex + 1, memory_order_release);
+
   return newFragment;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Int16* AudioQueue::dequeue(Int16* fragment)
 {
-  const lock_guard<mutex> guard(myMutex);
+  uInt64 readIndex = myReadIndex.load(memory_order_relaxed);
 
-  if (mySize == 0) return nullptr;
+  // Acquire the fragments that the producer has published
+  const uInt64 writeIndex = myWriteIndex.load(memory_order_acquire);
+  if (writeIndex == readIndex) {
+    myUnderflowCount.fetch_add(1, memory_order_relaxed);
+
+    return nullptr;
+  }
+
+  // Skip (drop) the oldest fragments if the queue has been overrun; their
+  // slots simply become free
+  if (writeIndex - readIndex > myCapacity)
+    readIndex = writeIndex - myCapacity;
 
   if (!fragment) {
     if (!myFirstFragmentForDequeue) throw runtime_error("dequeue called empty");
@@ -116,11 +138,12 @@ Int16* AudioQueue::dequeue(Int16* fragment)
     myFirstFragmentForDequeue = nullptr;
   }
 
-  Int16* nextFragment = myFragmentQueue.at(myNextFragment);
-  myFragmentQueue.at(myNextFragment) = fragment;
+  Int16*& slot = myFragmentQueue[readIndex % myFragmentQueue.size()];
+  Int16* nextFragment = slot;
+  slot = fragment;
 
-  --mySize;
-  myNextFragment = (myNextFragment + 1) % myFragmentQueue.size();
+  // Hand the slot (and the returned fragment) back to the producer
+  myReadIndex.store(readIndex + 1, memory_order_release);
 
   return nextFragment;
 }
@@ -128,8 +151,6 @@ Int16* AudioQueue::dequeue(Int16* fragment)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AudioQueue::closeSink(Int16* fragment)
 {
-  const lock_guard<mutex> guard(myMutex);
-
   if (myFirstFragmentForDequeue && fragment)
     throw runtime_error("attempt to return unknown buffer on closeSink");
 
@@ -142,3 +163,15 @@ void AudioQueue::ignoreOverflows(bool shouldIgnoreOverflows)
 {
   myIgnoreOverflows = shouldIgnoreOverflows;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 AudioQueue::overflowCount() const
+{
+  return myOverflowCount.load(memory_order_relaxed);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 AudioQueue::underflowCount() const
+{
+  return myUnderflowCount.load(memory_order_relaxed);
+}
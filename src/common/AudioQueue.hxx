@@ -18,7 +18,7 @@
 #ifndef AUDIO_QUEUE_HXX
 #define AUDIO_QUEUE_HXX
 
-#include <mutex>
+#include <atomic>
 
 #include "bspf.hxx"
 #include "StaggeredLogger.hxx"
@@ -33,6 +33,18 @@
   The queue needs to be threadsafe as the (SDL) audio driver runs on a
   separate thread. Samples are stored as signed 16 bit integers
   (platform endian).
+
+  There is exactly one producer (the TIA, calling enqueue) and one consumer
+  (the audio driver, calling dequeue and closeSink), so the queue is
+  implemented as a wait-free single-producer / single-consumer ring. The
+  slots outside of the queued range hold the free fragments of the pool.
+
+  If more than 'capacity' fragments are queued, the oldest ones are dropped,
+  so that the latency stays bounded. Since only the consumer may release
+  slots, the ring has room for twice the capacity, and the consumer skips
+  the surplus fragments on its next dequeue. Only if the consumer stalls
+  for longer than that, newly enqueued fragments are handed back to the
+  producer and dropped instead.
 */
 class AudioQueue
 {
@@ -96,6 +108,16 @@ class AudioQueue
      */
     void ignoreOverflows(bool shouldIgnoreOverflows);
 
+    /**
+      The number of fragments that have been dropped because the queue was full.
+     */
+    uInt64 overflowCount() const;
+
+    /**
+      The number of times a fragment was requested from the empty queue.
+     */
+    uInt64 underflowCount() const;
+
   private:
 
     // The size of an individual fragment (in stereo / mono samples)
@@ -104,7 +126,12 @@ class AudioQueue
     // Are we using stereo samples?
     bool myIsStereo{false};
 
-    // The fragment queue
+    // The number of fragments that can be queued before the oldest are dropped
+    uInt32 myCapacity{0};
+
+    // The fragment queue, with twice the capacity. Slot (i % size) holds a
+    // queued fragment for myReadIndex <= i < myWriteIndex, and a free
+    // fragment otherwise.
     vector<Int16*> myFragmentQueue;
 
     // All fragments, including the two fragments that are in circulation.
@@ -113,14 +140,15 @@ class AudioQueue
     // We allocate a consecutive slice of memory for the fragments.
     unique_ptr<Int16[]> myFragmentBuffer;
 
-    // The nubmer if queued fragments
-    uInt32 mySize{0};
+    // The number of fragments dequeued (written by the consumer only)
+    alignas(64) std::atomic<uInt64> myReadIndex{0};
 
-    // The next fragment.
-    uInt32 myNextFragment{0};
+    // The number of fragments enqueued (written by the producer only)
+    alignas(64) std::atomic<uInt64> myWriteIndex{0};
 
-    // We need a mutex for thread safety.
-    mutable std::mutex myMutex;
+    // Instrumentation
+    std::atomic<uInt64> myOverflowCount{0};
+    std::atomic<uInt64> myUnderflowCount{0};
 
     // The first (empty) enqueue call returns this fragment.
     Int16* myFirstFragmentForEnqueue{nullptr};
@@ -128,7 +156,7 @@ class AudioQueue
     Int16* myFirstFragmentForDequeue{nullptr};
 
     // Log overflows?
-    bool myIgnoreOverflows{true};
+    std::atomic<bool> myIgnoreOverflows{true};
 
     StaggeredLogger myOverflowLogger{"audio buffer overflow", Logger::Level::INFO};
 
@@ -49,6 +49,8 @@ FSNodeZIP::FSNodeZIP(string_view p)
 
 // cerr << " => p: " << p << endl;
 
+  const std::lock_guard<std::mutex> lock(myZipMutex);
+
   // Open file at least once to initialize the virtual file count
   try
   {
@@ -150,9 +152,13 @@ bool FSNodeZIP::exists() const
   if(_realNode && _realNode->exists())
   {
     // We need to inspect the actual path, not just the ZIP file itself
+    const std::lock_guard<std::mutex> lock(myZipMutex);
     try
     {
       myZipHandler->open(_zipFile);
+      if(myZipHandler->find(_virtualPath))
+        return true;
+
       while(myZipHandler->hasNext())
       {
         const auto& [name, size] = myZipHandler->next();
@@ -176,6 +182,8 @@ bool FSNodeZIP::getChildren(AbstractFSList& myList, ListMode mode) const
   if(!isDirectory() || _error != zip_error::NONE)
     return false;
 
+  const std::lock_guard<std::mutex> lock(myZipMutex);
+
   std::set<string> dirs;
   myZipHandler->open(_zipFile);
   while(myZipHandler->hasNext())
@@ -220,16 +228,10 @@ size_t FSNodeZIP::read(ByteBuffer& buffer, size_t) const
     case zip_error::NO_ROMS:      throw runtime_error("ZIP file doesn't contain any ROMs");
   }
 
+  const std::lock_guard<std::mutex> lock(myZipMutex);
   myZipHandler->open(_zipFile);
 
-  bool found = false;
-  while(myZipHandler->hasNext() && !found)
-  {
-    const auto& [name, size] = myZipHandler->next();
-    found = name == _virtualPath;
-  }
-
-  return found ? myZipHandler->decompress(buffer) : 0;
+  return myZipHandler->find(_virtualPath) ? myZipHandler->decompress(buffer) : 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -283,4 +285,7 @@ AbstractFSNodePtr FSNodeZIP::getParent() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 unique_ptr<ZipHandler> FSNodeZIP::myZipHandler = make_unique<ZipHandler>();
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::mutex FSNodeZIP::myZipMutex;
+
 #endif  // ZIP_SUPPORT
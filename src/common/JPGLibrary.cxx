@@ -36,18 +36,10 @@ JPGLibrary::JPGLibrary(OSystem& osystem)
 void JPGLibrary::loadImage(const string& filename, FBSurface& surface,
                            VariantList& metaData)
 {
-  std::ifstream in(filename, std::ios_base::binary | std::ios::ate);
-  if(!in.is_open())
-    throw runtime_error("No image found");
-  const size_t size = in.tellg();
-  in.clear();
-  in.seekg(0);
+  const size_t size = readFile(filename, myFileBuffer);
 
-  // Create space for the entire file
-  if(size > myFileBuffer.capacity())
-    myFileBuffer.reserve(size * 1.5);
-  if(!in.read(myFileBuffer.data(), size))
-    throw runtime_error("JPG image data reading failed");
+  // nanojpeg keeps its state in a global context
+  const std::lock_guard<std::mutex> lock(myDecodeMutex);
 
   if(njDecode(myFileBuffer.data(), static_cast<int>(size)))
     throw runtime_error("Error decoding the JPG image");
@@ -68,6 +60,62 @@ void JPGLibrary::loadImage(const string& filename, FBSurface& surface,
   njDone();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void JPGLibrary::loadImage(const string& filename, ByteArray& pixels,
+                           Common::Size& size, VariantList& metaData)
+{
+  // Use a separate file buffer, since this may be called from other threads
+  std::vector<char> fileBuffer;
+  const size_t fileSize = readFile(filename, fileBuffer);
+
+  {
+    // nanojpeg keeps its state in a global context
+    const std::lock_guard<std::mutex> lock(myDecodeMutex);
+
+    if(njDecode(fileBuffer.data(), static_cast<int>(fileSize)))
+      throw runtime_error("Error decoding the JPG image");
+
+    size = Common::Size(njGetWidth(), njGetHeight());
+    pixels.resize(static_cast<size_t>(size.w) * size.h * 4);
+
+    // Add an opaque alpha channel to the RGB triples (or grayscale values)
+    const bool isColor = njIsColor();
+    const uInt8* i_ptr = njGetImage();
+    uInt8* p_ptr = pixels.data();
+
+    for(size_t i = 0; i < pixels.size(); i += 4, i_ptr += isColor ? 3 : 1)
+    {
+      *p_ptr++ = *i_ptr;
+      *p_ptr++ = *(i_ptr + (isColor ? 1 : 0));
+      *p_ptr++ = *(i_ptr + (isColor ? 2 : 0));
+      *p_ptr++ = 0xff;
+    }
+    njDone();
+  }
+
+  // Read the meta data we got
+  readMetaData(filename, metaData);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t JPGLibrary::readFile(const string& filename, std::vector<char>& buffer)
+{
+  std::ifstream in(filename, std::ios_base::binary | std::ios::ate);
+  if(!in.is_open())
+    throw runtime_error("No image found");
+  const size_t size = in.tellg();
+  in.clear();
+  in.seekg(0);
+
+  // Create space for the entire file
+  if(size > buffer.size())
+    buffer.resize(size * 1.5);
+  if(!in.read(buffer.data(), size))
+    throw runtime_error("JPG image data reading failed");
+
+  return size;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void JPGLibrary::loadImagetoSurface(FBSurface& surface)
 {
@@ -117,5 +165,6 @@ void JPGLibrary::readMetaData(const string& filename, VariantList& metaData)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 std::vector<char> JPGLibrary::myFileBuffer;
+std::mutex JPGLibrary::myDecodeMutex;
 
 #endif  // IMAGE_SUPPORT
@@ -23,6 +23,9 @@
 class OSystem;
 class FBSurface;
 
+#include <mutex>
+#include "Rect.hxx"
+
 /**
   This class implements a thin wrapper around the nanojpeg library, and
   abstracts all the irrelevant details other loading an actual image.
@@ -49,6 +52,22 @@ class JPGLibrary
     void loadImage(const string& filename, FBSurface& surface,
                    VariantList& metaData);
 
+    /**
+      Read a JPG image from the specified file into a buffer of RGBA pixels.
+      In contrast to the method above, no shared storage is used, so this
+      method can also be called from other threads.
+
+      @param filename  The filename to load the JPG image
+      @param pixels    The RGBA pixel data of the JPG image
+      @param size      The size of the JPG image
+      @param metaData  The meta data of the JPG image
+
+      @post  On failure, a runtime_error is thrown containing a more
+             detailed error message.
+    */
+    static void loadImage(const string& filename, ByteArray& pixels,
+                          Common::Size& size, VariantList& metaData);
+
   private:
     // Global OSystem object
     OSystem& myOSystem;
@@ -62,6 +81,19 @@ class JPGLibrary
     ReadInfoType myReadInfo;
     static std::vector<char> myFileBuffer;
 
+    // The decoder uses a global state, so decoding must be serialized
+    static std::mutex myDecodeMutex;
+
+    /**
+      Read the whole JPG file into the given buffer.
+
+      @param filename  The filename to load the JPG image
+      @param buffer    The buffer for the file data, enlarged if necessary
+
+      @return  The size of the file
+    */
+    static size_t readFile(const string& filename, std::vector<char>& buffer);
+
     /**
       Load the JPG data from 'ReadInfo' into the FBSurface.  The surface
       is resized as necessary to accommodate the data.
@@ -55,7 +55,7 @@ void Logger::logMessage(string_view message, Level level)
 
   if(level == Logger::Level::ERR)
   {
-    cout << message << endl << std::flush;
+    *myErrorStream << message << endl << std::flush;
     myLogMessages += message;
     myLogMessages += "\n";
   }
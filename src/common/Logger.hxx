@@ -51,6 +51,10 @@ class Logger {
     void setLogParameters(int logLevel, bool logToConsole);
     void setLogParameters(Level logLevel, bool logToConsole);
 
+    // Errors are always shown on stdout, unless it is reserved for other
+    // output (e.g. a benchmark report)
+    void setErrorStream(std::ostream& stream) { myErrorStream = &stream; }
+
     const string& logMessages() const { return myLogMessages; }
 
   protected:
@@ -59,6 +63,7 @@ class Logger {
   private:
     int myLogLevel{static_cast<int>(Level::MAX)};
     bool myLogToConsole{true};
+    std::ostream* myErrorStream{&cout};
 
     // The list of log messages
     string myLogMessages;
@@ -35,6 +35,45 @@ PNGLibrary::PNGLibrary(OSystem& osystem)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PNGLibrary::loadImage(const string& filename, FBSurface& surface,
                            VariantList& metaData)
+{
+  const bool hasAlpha = readImage(filename, ReadInfo, metaData);
+
+  // Load image into the surface, setting the correct dimensions
+  loadImagetoSurface(surface, hasAlpha);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::loadImage(const string& filename, ByteArray& pixels,
+                           Common::Size& size, VariantList& metaData)
+{
+  // Use separate storage, since this may be called from other threads
+  ReadInfoType info;
+  const bool hasAlpha = readImage(filename, info, metaData);
+
+  size = Common::Size(info.width, info.height);
+  pixels.resize(static_cast<size_t>(info.width) * info.height * 4);
+
+  if(hasAlpha)
+    std::copy_n(info.buffer.begin(), pixels.size(), pixels.begin());
+  else
+  {
+    // Add an opaque alpha channel to the RGB triples
+    const uInt8* i_ptr = info.buffer.data();
+    uInt8* p_ptr = pixels.data();
+
+    for(size_t i = 0; i < pixels.size(); i += 4, i_ptr += 3)
+    {
+      *p_ptr++ = *i_ptr;
+      *p_ptr++ = *(i_ptr + 1);
+      *p_ptr++ = *(i_ptr + 2);
+      *p_ptr++ = 0xff;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool PNGLibrary::readImage(const string& filename, ReadInfoType& info,
+                           VariantList& metaData)
 {
   png_structp png_ptr{nullptr};
   png_infop info_ptr{nullptr};
@@ -104,15 +143,15 @@ void PNGLibrary::loadImage(const string& filename, FBSurface& surface,
   }
 
   // Create/initialize storage area for the current image
-  if(!allocateStorage(iwidth, iheight, hasAlpha))
+  if(!allocateStorage(info, iwidth, iheight, hasAlpha))
     loadImageERROR("Not enough memory to read PNG image");
 
   // The PNG read function expects an array of rows, not a single 1-D array
-  for(uInt32 irow = 0, offset = 0; irow < ReadInfo.height; ++irow, offset += ReadInfo.pitch)
-    ReadInfo.row_pointers[irow] = ReadInfo.buffer.data() + offset;
+  for(uInt32 irow = 0, offset = 0; irow < info.height; ++irow, offset += info.pitch)
+    info.row_pointers[irow] = info.buffer.data() + offset;
 
   // Read the entire image in one go
-  png_read_image(png_ptr, ReadInfo.row_pointers.data());
+  png_read_image(png_ptr, info.row_pointers.data());
 
   // We're finished reading
   png_read_end(png_ptr, info_ptr);
@@ -120,12 +159,11 @@ void PNGLibrary::loadImage(const string& filename, FBSurface& surface,
   // Read the meta data we got
   readMetaData(png_ptr, info_ptr, metaData);
 
-  // Load image into the surface, setting the correct dimensions
-  loadImagetoSurface(surface, hasAlpha);
-
   // Cleanup
   if(png_ptr)
     png_destroy_read_struct(&png_ptr, info_ptr ? &info_ptr : nullptr, nullptr);
+
+  return hasAlpha;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -389,20 +427,21 @@ void PNGLibrary::takeSnapshot(uInt32 number)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool PNGLibrary::allocateStorage(size_t width, size_t height, bool hasAlpha)
+bool PNGLibrary::allocateStorage(ReadInfoType& info, size_t width,
+                                 size_t height, bool hasAlpha)
 {
   // Create space for the entire image (3(4) bytes per pixel in RGB(A) format)
   const size_t req_buffer_size = width * height * (hasAlpha ? 4 : 3);
-  if(req_buffer_size > ReadInfo.buffer.capacity())
-    ReadInfo.buffer.resize(req_buffer_size * 1.5);
+  if(req_buffer_size > info.buffer.capacity())
+    info.buffer.resize(req_buffer_size * 1.5);
 
   const size_t req_row_size = height;
-  if(req_row_size > ReadInfo.row_pointers.capacity())
-    ReadInfo.row_pointers.resize(req_row_size * 1.5);
+  if(req_row_size > info.row_pointers.capacity())
+    info.row_pointers.resize(req_row_size * 1.5);
 
-  ReadInfo.width  = static_cast<png_uint_32>(width);
-  ReadInfo.height = static_cast<png_uint_32>(height);
-  ReadInfo.pitch  = static_cast<png_uint_32>(width * (hasAlpha ? 4 : 3));
+  info.width  = static_cast<png_uint_32>(width);
+  info.height = static_cast<png_uint_32>(height);
+  info.pitch  = static_cast<png_uint_32>(width * (hasAlpha ? 4 : 3));
 
   return true;
 }
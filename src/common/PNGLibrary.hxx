@@ -52,6 +52,22 @@ class PNGLibrary
     void loadImage(const string& filename, FBSurface& surface,
                    VariantList& metaData);
 
+    /**
+      Read a PNG image from the specified file into a buffer of RGBA pixels.
+      In contrast to the method above, no shared storage is used, so this
+      method can also be called from other threads.
+
+      @param filename  The filename to load the PNG image
+      @param pixels    The RGBA pixel data of the PNG image
+      @param size      The size of the PNG image
+      @param metaData  The meta data of the PNG image
+
+      @post  On failure, a runtime_error is thrown containing a more
+             detailed error message.
+    */
+    static void loadImage(const string& filename, ByteArray& pixels,
+                          Common::Size& size, VariantList& metaData);
+
     /**
       Save the current FrameBuffer image to a PNG file.  Note that in most
       cases this will be a TIA image, but it could actually be used for
@@ -146,14 +162,28 @@ class PNGLibrary
       basic memory manager, so that we don't constantly allocate and deallocate
       memory for each image loaded.
 
-      The method fills the 'ReadInfo' struct with valid memory locations
+      The method fills the given 'ReadInfo' struct with valid memory locations
       dependent on the given dimensions.  If memory has been previously
       allocated and it can accommodate the given dimensions, it is used directly.
 
+      @param info    The storage to fill
       @param width   The width of the PNG image
       @param height  The height of the PNG image
     */
-    static bool allocateStorage(size_t width, size_t height, bool hasAlpha);
+    static bool allocateStorage(ReadInfoType& info, size_t width,
+                                size_t height, bool hasAlpha);
+
+    /**
+      The actual method which reads a PNG image into the given storage.
+
+      @param filename  The filename to load the PNG image
+      @param info      The storage for the PNG data
+      @param metaData  The meta data of the PNG image
+
+      @return  True if the image data contains an alpha channel
+    */
+    static bool readImage(const string& filename, ReadInfoType& info,
+                          VariantList& metaData);
 
     /** The actual method which saves a PNG image.
 
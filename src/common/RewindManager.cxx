@@ -26,6 +26,97 @@
 
 #include "RewindManager.hxx"
 
+namespace {
+
+  // Equal bytes shorter than this are included in a literal run, since
+  // starting a new run would cost more than it saves
+  constexpr size_t MIN_ZERO_RUN = 4;
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void putLength(ByteArray& out, size_t length)
+  {
+    while(length >= 0x80)
+    {
+      out.push_back(static_cast<uInt8>(length | 0x80));
+      length >>= 7;
+    }
+    out.push_back(static_cast<uInt8>(length));
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  size_t getLength(const uInt8*& in)
+  {
+    size_t length = 0;
+    int shift = 0;
+
+    while(*in & 0x80)
+    {
+      length |= static_cast<size_t>(*in++ & 0x7f) << shift;
+      shift += 7;
+    }
+    return length | (static_cast<size_t>(*in++) << shift);
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // The delta is XOR encoded against the keyframe and stored as a sequence of
+  // (unchanged length, changed length, changed bytes XOR keyframe) entries.
+  void encodeDelta(const ByteArray& keyframe, const ByteArray& data, ByteArray& delta)
+  {
+    const size_t size = data.size();
+    size_t i = 0;
+
+    delta.clear();
+    while(i < size)
+    {
+      const size_t zeroStart = i;
+      while(i < size && data[i] == keyframe[i])
+        ++i;
+
+      const size_t literalStart = i;
+      while(i < size)
+      {
+        if(data[i] != keyframe[i])
+        {
+          ++i;
+          continue;
+        }
+        // Only end the literal run at a sufficiently long run of equal bytes
+        size_t j = i;
+        while(j < size && j - i < MIN_ZERO_RUN && data[j] == keyframe[j])
+          ++j;
+        if(j - i >= MIN_ZERO_RUN || j == size)
+          break;
+        i = j;
+      }
+
+      putLength(delta, literalStart - zeroStart);
+      putLength(delta, i - literalStart);
+      for(size_t k = literalStart; k < i; ++k)
+        delta.push_back(data[k] ^ keyframe[k]);
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void decodeDelta(const ByteArray& keyframe, const ByteArray& delta, ByteArray& data)
+  {
+    data = keyframe;
+
+    const uInt8* in = delta.data();
+    const uInt8* const end = in + delta.size();
+    size_t pos = 0;
+
+    while(in < end)
+    {
+      pos += getLength(in);
+
+      const size_t length = getLength(in);
+      for(size_t k = 0; k < length; ++k)
+        data[pos++] ^= *in++;
+    }
+  }
+
+} // namespace
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 RewindManager::RewindManager(OSystem& system, StateManager& statemgr)
   : myOSystem{system},
@@ -118,6 +209,11 @@ bool RewindManager::addState(string_view message, bool timeMachine)
       return false;
   }
 
+  Serializer& s = mySerializer;
+  s.reset();
+  if(!myStateManager.saveState(s) || !myOSystem.console().tia().saveDisplay(s))
+    return false;
+
   // Remove all future states
   myStateList.removeToLast();
 
@@ -129,17 +225,15 @@ bool RewindManager::addState(string_view message, bool timeMachine)
   // This updates the 'current' iterator inside the list
   myStateList.addLast();
   RewindState& state = myStateList.current();
-  Serializer& s = state.data;
 
-  s.rewind();  // rewind Serializer internal buffers
-  if(myStateManager.saveState(s) && myOSystem.console().tia().saveDisplay(s))
-  {
-    state.message = message;
-    state.cycles = myOSystem.console().tia().cycles();
-    myLastTimeMachineAdd = timeMachine;
-    return true;
-  }
-  return false;
+  ByteArray& data = myStateData;
+  data.assign(s.data(), s.data() + s.size());
+  storeState(state, data);
+
+  state.message = message;
+  state.cycles = myOSystem.console().tia().cycles();
+  myLastTimeMachineAdd = timeMachine;
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -161,10 +255,6 @@ uInt32 RewindManager::rewindStates(uInt32 numStates)
         // ...except when the last state was added automatically,
         // because that already happened one interval before
         myLastTimeMachineAdd = false;
-
-      RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      s.rewind();  // rewind Serializer internal buffers
     }
     else
       break;
@@ -196,10 +286,6 @@ uInt32 RewindManager::unwindStates(uInt32 numStates)
       // Set internal current iterator to nextCycles state (forward in time),
       // since we will now process this state
       myStateList.moveToNext();
-
-      RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      s.rewind();  // rewind Serializer internal buffers
     }
     else
       break;
@@ -254,18 +340,15 @@ string RewindManager::saveAllStates()
 
     for (uInt32 i = 0; i < numStates; ++i)
     {
-      RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      const auto stateSize = static_cast<uInt32>(s.size());
+      const RewindState& state = myStateList.current();
+      ByteArray& buffer = myStateData;
+      restoreState(state, buffer);
 
-      out.putInt(stateSize);
+      const auto stateSize = static_cast<uInt32>(buffer.size());
 
-      // Rewind Serializer internal buffers
-      s.rewind();
+      out.putInt(stateSize);
 
       // Save state
-      ByteArray buffer(stateSize);
-      s.getByteArray(buffer.data(), stateSize);
       out.putByteArray(buffer.data(), stateSize);
       out.putString(state.message);
       out.putLong(state.cycles);
@@ -321,15 +404,12 @@ string RewindManager::loadAllStates()
       // This updates the 'current' iterator inside the list
       myStateList.addLast();
       RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-
-      // Rewind Serializer internal buffers
-      s.rewind();
 
       // Fill new state with saved values
-      ByteArray buffer(stateSize);
+      ByteArray& buffer = myStateData;
+      buffer.resize(stateSize);
       in.getByteArray(buffer.data(), stateSize);
-      s.putByteArray(buffer.data(), stateSize);
+      storeState(state, buffer);
       state.message = in.getString();
       state.cycles = in.getLong();
     }
@@ -381,12 +461,52 @@ void RewindManager::compressStates()
    myStateList.remove(removeIter); // remove
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::storeState(RewindState& state, const ByteArray& data)
+{
+  // Try to encode the state as a delta against the current keyframe, unless
+  // it is time for a new keyframe anyway
+  if(myKeyframe && myKeyframe->size() == data.size() &&
+     myStatesSinceKeyframe < KEYFRAME_INTERVAL)
+  {
+    encodeDelta(*myKeyframe, data, myDeltaData);
+
+    // States that differ too much start a new keyframe instead
+    if(myDeltaData.size() <= data.size() / 2)
+    {
+      state.keyframe = myKeyframe;
+      state.delta.assign(myDeltaData.begin(), myDeltaData.end());
+      state.delta.shrink_to_fit();
+      ++myStatesSinceKeyframe;
+      return;
+    }
+  }
+
+  myKeyframe = make_shared<const ByteArray>(data);
+  myStatesSinceKeyframe = 1;
+
+  state.keyframe = myKeyframe;
+  state.delta.clear();
+  state.delta.shrink_to_fit();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::restoreState(const RewindState& state, ByteArray& data)
+{
+  decodeDelta(*state.keyframe, state.delta, data);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string RewindManager::loadState(Int64 startCycles, uInt32 numStates)
 {
-  RewindState& state = myStateList.current();
-  Serializer& s = state.data;
+  const RewindState& state = myStateList.current();
+
+  restoreState(state, myStateData);
 
+  Serializer& s = mySerializer;
+  s.reset();
+  s.putByteArray(myStateData.data(), myStateData.size());
+  s.rewind();
   myStateManager.loadState(s);
   myOSystem.console().tia().loadDisplay(s);
 
@@ -22,6 +22,7 @@ class OSystem;
 class StateManager;
 
 #include "LinkedObjectPool.hxx"
+#include "Serializer.hxx"
 #include "bspf.hxx"
 
 /**
@@ -41,6 +42,12 @@ class StateManager;
   If the list is full, states are either removed at the beginning (compression
   off) or at selective positions (compression on).
 
+  To save memory, only every KEYFRAME_INTERVAL'th state (a keyframe) is stored
+  completely. All other states are stored as run-length encoded XOR deltas
+  against the last keyframe, and are reconstructed when they are loaded.
+  Since every state refers to its keyframe directly (and shares ownership of
+  it), states can still be removed at any position.
+
   @author  Stephen Anthony
 */
 class RewindManager
@@ -50,6 +57,8 @@ class RewindManager
 
   public:
     static constexpr uInt32 MAX_BUF_SIZE = 1000;
+    // A complete state is stored (at least) every KEYFRAME_INTERVAL states
+    static constexpr uInt32 KEYFRAME_INTERVAL = 16;
     static constexpr int NUM_INTERVALS = 7;
     // cycle values for the intervals
     const std::array<uInt32, NUM_INTERVALS> INTERVAL_CYCLES = {
@@ -145,6 +154,7 @@ class RewindManager
     void resize(uInt32 size) { myStateList.resize(size); }
     void clear() {
       myStateList.clear();
+      myKeyframe.reset();
     }
 
     /**
@@ -178,7 +188,8 @@ class RewindManager
     bool   myLastTimeMachineAdd{false};
 
     struct RewindState {
-      Serializer data;  // actual save state
+      shared_ptr<const ByteArray> keyframe; // complete state the delta refers to
+      ByteArray delta;  // XOR/RLE delta against keyframe (empty for keyframes)
       string message;   // describes save state origin
       uInt64 cycles{0}; // cycles since emulation started
 
@@ -201,11 +212,33 @@ class RewindManager
     // frequent (de)-allocations)
     Common::LinkedObjectPool<RewindState> myStateList;
 
+    // The keyframe new states are encoded against
+    shared_ptr<const ByteArray> myKeyframe;
+    uInt32 myStatesSinceKeyframe{0};
+
+    // Scratch buffers for (de)compressing states
+    ByteArray myStateData;
+    ByteArray myDeltaData;
+
+    // Reused for (de)serializing states, to avoid reallocating its buffer
+    Serializer mySerializer;
+
     /**
       Remove a save state from the list
     */
     void compressStates();
 
+    /**
+      Store the given (complete) state data into the given list entry, either
+      as a new keyframe or as a delta against the current keyframe.
+    */
+    void storeState(RewindState& state, const ByteArray& data);
+
+    /**
+      Reconstruct the complete state data of the given list entry.
+    */
+    static void restoreState(const RewindState& state, ByteArray& data);
+
     /**
       Load the current state and get the message string for the rewind/unwind
 
@@ -0,0 +1,348 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2023 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <unordered_set>
+
+#include "Bankswitch.hxx"
+#include "Cart.hxx"
+#include "CartDetector.hxx"
+#include "FSNodeFactory.hxx"
+#include "MD5.hxx"
+#include "OSystem.hxx"
+#include "json_lib.hxx"
+
+#include "RomIndexer.hxx"
+
+using json = nlohmann::json;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomIndexer::RomIndexer(const shared_ptr<KeyValueRepositoryAtomic>& repository)
+  : myRepository{repository}
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomIndexer::~RomIndexer()
+{
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+
+    myQuit = true;
+  }
+  myWakeup.notify_all();
+
+  for(auto& thread: myThreads)
+    thread.join();
+
+  saveIndex();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::index(const FSList& files)
+{
+  // Save the results of the previous directory
+  saveIndex();
+  loadIndex();
+
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+
+    // ROMs in ZIP archives are queued by their archive
+    std::unordered_set<string> archives;
+
+    myQueue.clear();
+    for(const auto& file: files)
+      if(file.isFile() && Bankswitch::isValidRomName(file))
+      {
+        const string& path = file.getPath();
+        const size_t pos = BSPF::findIgnoreCase(path, ".zip");
+
+        if(pos == string::npos)
+          myQueue.push_back(path);
+        else if(archives.insert(path.substr(0, pos + 4)).second)
+          myQueue.push_back(path.substr(0, pos + 4));
+      }
+  }
+  if(myThreads.empty())
+  {
+    // Leave one core for the UI; more threads would only compete for the disk
+    const uInt32 numThreads =
+      BSPF::clamp(std::thread::hardware_concurrency(), 2U, 5U) - 1;
+
+    for(uInt32 i = 0; i < numThreads; ++i)
+      myThreads.emplace_back(&RomIndexer::threadMain, this);
+  }
+  myWakeup.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndexer::get(const FSNode& node, Entry& entry)
+{
+  if(!node.isFile() || !Bankswitch::isValidRomName(node))
+    return false;
+
+  loadIndex();
+
+  const string& path = node.getPath();
+  Entry file;
+
+  file.fileSize = node.getSize();
+  file.modified = node.getModifiedTime();
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+
+    if(find(path, file, entry))
+      return true;
+  }
+
+  entry = file;
+  if(!create(node, entry))
+    return false;
+
+  bool idle = false;
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+
+    store(path, entry);
+    idle = myQueue.empty();
+  }
+  if(idle)
+    saveIndex();
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndexer::lookup(const FSNode& node, Entry& entry)
+{
+  if(!node.isFile() || !Bankswitch::isValidRomName(node))
+    return false;
+
+  loadIndex();
+
+  Entry file;
+
+  file.fileSize = node.getSize();
+  file.modified = node.getModifiedTime();
+
+  const std::lock_guard<std::mutex> lock(myMutex);
+
+  return find(node.getPath(), file, entry);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndexer::create(const FSNode& node, Entry& entry)
+{
+  size_t size = 0;
+  const ByteBuffer image = OSystem::openROM(node, size, false);
+
+  if(!image)
+    return false;
+
+  create(image, size, entry);
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::create(const ByteBuffer& image, size_t size, Entry& entry)
+{
+  entry.md5 = MD5::hash(image, size);
+  entry.type = Bankswitch::typeToName(CartDetector::autodetectType(image, size));
+  entry.romSize = size;
+  entry.isPlusROM = CartDetector::isProbablyPlusROM(image, size);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::indexArchive(const string& archive)
+{
+#if defined(ZIP_SUPPORT)
+  // ZIP entries use the modification time of their archive
+  const auto node = FSNodeFactory::create(archive, FSNodeFactory::Type::SYSTEM);
+  const uInt64 modified = node ? node->getModifiedTime() : 0;
+  if(modified == 0)
+    return;
+
+  // The handler of FSNodeZIP is used by the UI thread, so use our own
+  ZipHandler zip;
+  try
+  {
+    zip.open(archive);
+  }
+  catch(const runtime_error&)
+  {
+    return;
+  }
+
+  // Only decompress the ROMs which are not indexed yet
+  const auto filter = [&](const string& name, size_t size)
+  {
+    if(size > Cartridge::maxSize() || !Bankswitch::isValidRomName(name))
+      return false;
+
+    Entry file, entry;
+    file.fileSize = size;
+    file.modified = modified;
+
+    const std::lock_guard<std::mutex> lock(myMutex);
+    return !find(archive + "/" + name, file, entry);
+  };
+  const auto callback = [&](const string& name, const ByteBuffer& image, size_t size)
+  {
+    Entry entry;
+    entry.fileSize = size;
+    entry.modified = modified;
+    create(image, size, entry);
+
+    const std::lock_guard<std::mutex> lock(myMutex);
+    store(archive + "/" + name, entry);
+  };
+  // The indexer runs several jobs in parallel already, so don't spawn
+  // more threads per archive
+  zip.decompressAll(filter, callback, 1);
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndexer::find(const string& path, const Entry& file, Entry& entry) const
+{
+  // Without a modification time, changes cannot be detected
+  if(file.modified == 0)
+    return false;
+
+  const auto iter = myEntries.find(path);
+
+  if(iter == myEntries.end() || iter->second.fileSize != file.fileSize ||
+     iter->second.modified != file.modified)
+    return false;
+
+  entry = iter->second;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::store(const string& path, const Entry& entry)
+{
+  if(entry.modified == 0)
+    return;
+
+  myEntries[path] = entry;
+  myUnsaved.push_back(path);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::loadIndex()
+{
+  if(myLoaded)
+    return;
+
+  const KVRMap values = myRepository->load();
+  const std::lock_guard<std::mutex> lock(myMutex);
+
+  for(const auto& [path, value]: values)
+  {
+    try
+    {
+      const json data = json::parse(value.toString());
+      Entry entry;
+
+      entry.md5 = data.at("md5").get<string>();
+      entry.type = data.at("type").get<string>();
+      entry.romSize = data.at("romsize").get<size_t>();
+      entry.isPlusROM = data.at("plusrom").get<bool>();
+      entry.fileSize = data.at("size").get<uInt64>();
+      entry.modified = data.at("modified").get<uInt64>();
+      myEntries.emplace(path, entry);
+    }
+    catch(...)
+    {
+      // Ignore invalid entries, they will be recreated
+    }
+  }
+  myLoaded = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::saveIndex()
+{
+  KVRMap values;
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+
+    for(const auto& path: myUnsaved)
+    {
+      const Entry& entry = myEntries[path];
+      const json data = {
+        {"md5", entry.md5},
+        {"type", entry.type},
+        {"romsize", entry.romSize},
+        {"plusrom", entry.isPlusROM},
+        {"size", entry.fileSize},
+        {"modified", entry.modified}
+      };
+
+      values[path] = data.dump();
+    }
+    myUnsaved.clear();
+  }
+  if(!values.empty())
+    myRepository->save(values);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndexer::threadMain()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  while(true)
+  {
+    myWakeup.wait(lock, [this]{ return myQuit || !myQueue.empty(); });
+    if(myQuit)
+      break;
+
+    const string path = std::move(myQueue.front());
+    myQueue.pop_front();
+    lock.unlock();
+
+    // Only ZIP archives themselves are queued with their extension
+    if(BSPF::endsWithIgnoreCase(path, ".zip"))
+    {
+      indexArchive(path);
+      lock.lock();
+      continue;
+    }
+
+    // Create a new node, since nodes cache their state and must not be
+    // shared between threads
+    const FSNode node(path);
+    Entry file, entry;
+
+    file.fileSize = node.getSize();
+    file.modified = node.getModifiedTime();
+
+    lock.lock();
+    if(find(path, file, entry))
+      continue;
+    lock.unlock();
+
+    entry = file;
+    const bool valid = create(node, entry);
+
+    lock.lock();
+    if(valid)
+      store(path, entry);
+  }
+}
@@ -0,0 +1,126 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2023 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef ROM_INDEXER_HXX
+#define ROM_INDEXER_HXX
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "FSNode.hxx"
+#include "repository/KeyValueRepository.hxx"
+#include "bspf.hxx"
+
+/**
+  This class maintains an index of the ROM files shown in the launcher.
+  For each ROM, the MD5, the detected bankswitch type and the PlusROM state
+  are determined by a pool of background threads.  The results are stored
+  in the database, keyed by path and validated by file size and modification
+  time, so that they are only determined once.
+
+  ROMs inside ZIP archives are indexed per archive, using a separate ZIP
+  handler which decompresses all ROMs of the archive in parallel.
+*/
+class RomIndexer
+{
+  public:
+    struct Entry {
+      string md5;
+      string type;          // detected bankswitch type
+      size_t romSize{0};    // size of the ROM image
+      bool isPlusROM{false};
+      uInt64 fileSize{0};   // size and modification time of the file,
+      uInt64 modified{0};   // used for validating the entry
+    };
+
+  public:
+    explicit RomIndexer(const shared_ptr<KeyValueRepositoryAtomic>& repository);
+    ~RomIndexer();
+
+    /**
+      Queue the ROMs in the given list for indexing in the background.
+      ROMs still waiting from a previous call are discarded.
+
+      @param files  The list of files, non-ROM files are ignored
+    */
+    void index(const FSList& files);
+
+    /**
+      Get the index entry of the given ROM.  If there is no valid entry
+      yet, it is created immediately.
+
+      @param node   The ROM file
+      @param entry  The index entry for the ROM
+
+      @return  False if the file is not a valid ROM
+    */
+    bool get(const FSNode& node, Entry& entry);
+
+    /**
+      Get the index entry of the given ROM, if there is a valid one already.
+
+      @param node   The ROM file
+      @param entry  The index entry for the ROM
+
+      @return  False if the ROM has not been indexed yet
+    */
+    bool lookup(const FSNode& node, Entry& entry);
+
+  private:
+    // Determine the index data of the ROM
+    static bool create(const FSNode& node, Entry& entry);
+    static void create(const ByteBuffer& image, size_t size, Entry& entry);
+
+    // Index all ROMs in the ZIP archive which have no valid entry yet
+    void indexArchive(const string& archive);
+
+    // Find a valid entry for the path, must be called with the mutex locked
+    bool find(const string& path, const Entry& file, Entry& entry) const;
+    // Add an entry for the path, must be called with the mutex locked
+    void store(const string& path, const Entry& entry);
+
+    void loadIndex();
+    void saveIndex();
+
+    void threadMain();
+
+  private:
+    shared_ptr<KeyValueRepositoryAtomic> myRepository;
+
+    std::unordered_map<string, Entry> myEntries;
+    vector<string> myUnsaved;
+    bool myLoaded{false};
+
+    std::deque<string> myQueue;
+    vector<std::thread> myThreads;
+    std::mutex myMutex;
+    std::condition_variable myWakeup;
+    bool myQuit{false};
+
+  private:
+    // Following constructors and assignment operators not supported
+    RomIndexer() = delete;
+    RomIndexer(const RomIndexer&) = delete;
+    RomIndexer(RomIndexer&&) = delete;
+    RomIndexer& operator=(const RomIndexer&) = delete;
+    RomIndexer& operator=(RomIndexer&&) = delete;
+};
+
+#endif
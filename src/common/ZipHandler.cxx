@@ -18,6 +18,17 @@
 #if defined(ZIP_SUPPORT)
 
 #include <zlib.h>
+#include <atomic>
+#include <thread>
+
+#if defined(BSPF_UNIX) || defined(BSPF_MACOS)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#elif defined(BSPF_WINDOWS)
+  #include "Windows.hxx"
+#endif
 
 #include "Bankswitch.hxx"
 #include "ZipHandler.hxx"
@@ -34,12 +45,15 @@ void ZipHandler::open(const string& filename)
   ZipFilePtr ptr = findCached(filename);
   if(ptr)
   {
-    // Only a previously used entry will exist in the cache, so we know it's valid
-    myZip = std::move(ptr);
-
-    // Was already initialized; we just need to re-open it
-    if(!myZip->open())
+    // Only a previously used entry will exist in the cache, so we know it's
+    // valid; we just need to re-open it
+    const uInt64 length = ptr->myLength;
+    if(!ptr->open())
       throw runtime_error(errorMessage(ZipError::FILE_ERROR));
+
+    // Re-read the central directory if the file was changed meanwhile
+    if(ptr->myLength != length)
+      ptr->initialize();
   }
   else
   {
@@ -51,24 +65,8 @@ void ZipHandler::open(const string& filename)
     if(!ptr->open())
       throw runtime_error(errorMessage(ZipError::FILE_ERROR));
     ptr->initialize();
-
-    myZip = std::move(ptr);
-
-    // Count ROM files (we do it here so it will be cached)
-    try
-    {
-      while(hasNext())
-      {
-        const auto& [name, size] = next();
-        if(Bankswitch::isValidRomName(name))
-          myZip->myRomfiles++;
-      }
-    }
-    catch(...)
-    {
-      myZip->myRomfiles = 0;
-    }
   }
+  myZip = std::move(ptr);
 
   reset();  // Reset iterator to beginning for subsequent use
 }
@@ -77,14 +75,13 @@ void ZipHandler::open(const string& filename)
 void ZipHandler::reset()
 {
   // Reset the position and go from there
-  if(myZip)
-    myZip->myCdPos = 0;
+  myPos = myCurrent = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ZipHandler::hasNext() const
 {
-  return myZip && (myZip->myCdPos < myZip->myEcd.cdSize);
+  return myZip && (myPos < myZip->myFiles.size());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -92,33 +89,46 @@ std::tuple<string, size_t> ZipHandler::next()
 {
   if(hasNext())
   {
-    const ZipHeader* const header = myZip->nextFile();
-    if(!header)
-      throw runtime_error(errorMessage(ZipError::FILE_CORRUPT));
-    else if(header->uncompressedLength == 0)
-      return next();
-    else
-      return {header->filename, header->uncompressedLength};
+    myCurrent = myPos++;
+
+    const ZipHeader& header = myZip->myFiles[myCurrent];
+    return {header.filename, header.uncompressedLength};
   }
   return {EmptyString, 0};
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ZipHandler::find(const string& name)
+{
+  if(myZip)
+  {
+    const auto iter = myZip->myIndex.find(name);
+    if(iter != myZip->myIndex.end())
+    {
+      myCurrent = iter->second;
+      return true;
+    }
+  }
+  return false;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt64 ZipHandler::decompress(ByteBuffer& image)
 {
-  if(myZip && myZip->myHeader.uncompressedLength > 0)
+  if(myZip && myCurrent < myZip->myFiles.size())
   {
+    const ZipHeader& header = myZip->myFiles[myCurrent];
     try
     {
-      const uInt64 length = myZip->myHeader.uncompressedLength;
+      const uInt64 length = header.uncompressedLength;
       image = make_unique<uInt8[]>(length);
 
-      myZip->decompress(image, length);
+      myZip->decompress(header, image, length);
       return length;
     }
-    catch(const ZipError& err)
+    catch(const runtime_error&)
     {
-      throw runtime_error(errorMessage(err));
+      throw;
     }
     catch(...)
     {
@@ -129,6 +139,56 @@ uInt64 ZipHandler::decompress(ByteBuffer& image)
     throw runtime_error("Invalid ZIP archive");
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ZipHandler::decompressAll(const DecompressFilter& filter,
+                               const DecompressCallback& callback,
+                               uInt32 numThreads)
+{
+  if(!myZip)
+    return;
+
+  const ZipFile& zip = *myZip;
+  vector<const ZipHeader*> files;
+  for(const auto& header: zip.myFiles)
+    if(filter(header.filename, header.uncompressedLength))
+      files.push_back(&header);
+
+  // The file is mapped into memory and the index isn't modified, so each
+  // thread only needs its own output buffer
+  std::atomic<size_t> nextFile{0};
+  const auto worker = [&]()
+  {
+    size_t i = 0;
+    while((i = nextFile++) < files.size())
+    {
+      const ZipHeader& header = *files[i];
+      const uInt64 length = header.uncompressedLength;
+      ByteBuffer image;
+      try
+      {
+        image = make_unique<uInt8[]>(length);
+        zip.decompress(header, image, length);
+      }
+      catch(...)
+      {
+        continue;
+      }
+      callback(header.filename, image, length);
+    }
+  };
+
+  if(numThreads == 0)
+    numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+
+  vector<std::thread> threads;
+  for(size_t i = 1; i < std::min<size_t>(files.size(), numThreads); ++i)
+    threads.emplace_back(worker);
+  worker();
+
+  for(auto& thread: threads)
+    thread.join();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string ZipHandler::errorMessage(ZipError err)
 {
@@ -201,27 +261,94 @@ void ZipHandler::addToCache()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ZipHandler::ZipFile::ZipFile(const string& filename)
-  : myFilename{filename},
-    myBuffer{make_unique<uInt8[]>(DECOMPRESS_BUFSIZE)}
+  : myFilename{filename}
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ZipHandler::ZipFile::~ZipFile()
 {
-  std::fill(myBuffer.get(), myBuffer.get() + DECOMPRESS_BUFSIZE, 0);
+  close();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ZipHandler::ZipFile::open()
 {
-  myStream.open(myFilename, fstream::in | fstream::binary);
-  if(!myStream.is_open())
+  close();
+  myLength = 0;
+
+#if defined(BSPF_UNIX) || defined(BSPF_MACOS)
+  const int fd = ::open(myFilename.c_str(), O_RDONLY);
+  if(fd < 0)
+    return false;
+
+  struct stat st{};
+  if(fstat(fd, &st) == 0 && st.st_size > 0)
   {
-    myLength = 0;
+    void* const data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(data != MAP_FAILED)  // NOLINT
+    {
+      myData = static_cast<const uInt8*>(data);
+      myLength = st.st_size;
+    }
+  }
+  ::close(fd);  // the mapping stays valid
+  if(myData)
+    return true;
+#elif defined(BSPF_WINDOWS)
+  HANDLE file = CreateFileA(myFilename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(file == INVALID_HANDLE_VALUE)
     return false;
+
+  LARGE_INTEGER size{};
+  if(GetFileSizeEx(file, &size) && size.QuadPart > 0)
+  {
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mapping != nullptr)
+    {
+      const void* const data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      if(data != nullptr)
+      {
+        myFileHandle = file;
+        myMapHandle = mapping;
+        myData = static_cast<const uInt8*>(data);
+        myLength = size.QuadPart;
+        return true;
+      }
+      CloseHandle(mapping);
+    }
   }
-  myStream.exceptions( std::ios_base::failbit | std::ios_base::badbit | std::ios_base::eofbit );
-  myStream.seekg(0, std::ios::end);
-  myLength = myStream.tellg();
-  myStream.seekg(0, std::ios::beg);
+  CloseHandle(file);
+#endif
+
+  // The file can't be mapped (or this isn't supported), so read it completely
+  try
+  {
+    fstream in(myFilename, fstream::in | fstream::binary);
+    if(!in.is_open())
+      return false;
 
-  return true;
+    in.seekg(0, std::ios::end);
+    const auto length = static_cast<uInt64>(in.tellg());
+    in.seekg(0, std::ios::beg);
+
+    myBuffer = make_unique<uInt8[]>(length);
+    in.read(reinterpret_cast<char*>(myBuffer.get()), length);
+    if(static_cast<uInt64>(in.gcount()) != length)
+    {
+      myBuffer.reset();
+      return false;
+    }
+    myData = myBuffer.get();
+    myLength = length;
+    return true;
+  }
+  catch(...)
+  {
+    myBuffer.reset();
+    return false;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -235,64 +362,62 @@ void ZipHandler::ZipFile::initialize()
      myEcd.cdDiskEntries != myEcd.cdTotalEntries)
     throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
 
-  // Allocate memory for the central directory
-  try        { myCd = make_unique<uInt8[]>(myEcd.cdSize + 1); }
-  catch(...) { throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY)); }
-
   // Read the central directory
-  uInt64 read_length = 0;
-  const bool success = readStream(myCd, myEcd.cdStartDiskOffset, myEcd.cdSize, read_length);
-  if(!success)
-    throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-  else if(read_length != myEcd.cdSize)
+  if(myEcd.cdStartDiskOffset + myEcd.cdSize > myLength)
     throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
+
+  try
+  {
+    readCd();
+  }
+  catch(const runtime_error&)
+  {
+    throw;
+  }
+  catch(...)
+  {
+    throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY));
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ZipHandler::ZipFile::close()
 {
-  if(myStream.is_open())
-    myStream.close();
+  if(myData == nullptr)
+    return;
+
+  if(myBuffer)
+    myBuffer.reset();
+  else
+  {
+#if defined(BSPF_UNIX) || defined(BSPF_MACOS)
+    munmap(const_cast<uInt8*>(myData), myLength);  // NOLINT
+#elif defined(BSPF_WINDOWS)
+    UnmapViewOfFile(myData);
+    CloseHandle(static_cast<HANDLE>(myMapHandle));
+    CloseHandle(static_cast<HANDLE>(myFileHandle));
+    myMapHandle = myFileHandle = nullptr;
+#endif
+  }
+  myData = nullptr;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ZipHandler::ZipFile::readEcd()
 {
-  uInt64 buflen = 1024;
+  // The ECD is at the end of the file, followed by a comment of at most
+  // 64K; since the whole file is available, search for it backwards
+  const uInt64 minLength = EcdReader::minimumLength();
+  if(myLength < minLength)
+    throw runtime_error(errorMessage(ZipError::BAD_SIGNATURE));
 
-  // We may need multiple tries
-  while(buflen < 65536)
+  const uInt64 limit = myLength > minLength + 65535 ? myLength - minLength - 65535 : 0;
+  for(uInt64 offset = myLength - minLength + 1; offset-- > limit; )
   {
-    uInt64 read_length = 0;
-
-    // Max out the buf length at the size of the file
-    if(buflen > myLength)
-      buflen = myLength;
-
-    // Allocate buffer
-    const ByteBuffer buffer = make_unique<uInt8[]>(buflen + 1);
-    if(buffer == nullptr)
-      throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY));
-
-    // Read in one buffers' worth of data
-    const bool success = readStream(buffer, myLength - buflen, buflen, read_length);
-    if(!success || read_length != buflen)
-      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-
-    // Find the ECD signature
-    Int32 offset = 0;
-    for(offset = static_cast<Int32>(buflen - EcdReader::minimumLength()); offset >= 0; --offset)
-    {
-      const EcdReader reader(buffer.get() + offset);
-      if(reader.signatureCorrect() && ((reader.totalLength() + offset) <= buflen))
-        break;
-    }
-
-    // If we found it, fill out the data
-    if(offset >= 0)
+    const EcdReader reader(myData + offset);
+    if(reader.signatureCorrect() && ((reader.totalLength() + offset) <= myLength))
     {
       // Extract ECD info
-      const EcdReader reader(buffer.get() + offset);
       myEcd.diskNumber        = reader.thisDiskNo();
       myEcd.cdStartDiskNumber = reader.dirStartDisk();
       myEcd.cdDiskEntries     = reader.dirDiskEntries();
@@ -301,83 +426,85 @@ void ZipHandler::ZipFile::readEcd()
       myEcd.cdStartDiskOffset = reader.dirOffset();
       return;
     }
-
-    // Didn't find it; expand our search
-    if(buflen < myLength)
-      buflen *= 2;
-    else
-      throw runtime_error(errorMessage(ZipError::BAD_SIGNATURE));
   }
-  throw runtime_error(errorMessage(ZipError::OUT_OF_MEMORY));
+  throw runtime_error(errorMessage(ZipError::BAD_SIGNATURE));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ZipHandler::ZipFile::readStream(const ByteBuffer& out, uInt64 offset,
-                                     uInt64 length, uInt64& actual)
+void ZipHandler::ZipFile::readCd()
 {
-  try
-  {
-    myStream.seekg(offset);
-    myStream.read(reinterpret_cast<char*>(out.get()), length);
+  const uInt8* const cd = myData + myEcd.cdStartDiskOffset;
 
-    actual = myStream.gcount();
-    return true;
-  }
-  catch(...)
+  myFiles.clear();
+  myIndex.clear();
+  myRomfiles = 0;
+
+  myFiles.reserve(myEcd.cdTotalEntries);
+  myIndex.reserve(myEcd.cdTotalEntries);
+
+  for(uInt64 pos = 0; pos < myEcd.cdSize; )
   {
-    return false;
-  }
-}
+    // Make sure we have enough data
+    if(pos + CentralDirEntryReader::minimumLength() > myEcd.cdSize)
+      throw runtime_error(errorMessage(ZipError::FILE_CORRUPT));
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const ZipHandler::ZipHeader* ZipHandler::ZipFile::nextFile()
-{
-  // Make sure we have enough data
-  // If we're at or past the end, we're done
-  const CentralDirEntryReader reader(myCd.get() + myCdPos);
-  if(!reader.signatureCorrect() || ((myCdPos + reader.totalLength()) > myEcd.cdSize))
-    return nullptr;
-
-  // Extract file header info
-  myHeader.versionCreated     = reader.versionCreated();
-  myHeader.versionNeeded      = reader.versionNeeded();
-  myHeader.bitFlag            = reader.generalFlag();
-  myHeader.compression        = reader.compressionMethod();
-  myHeader.crc                = reader.crc32();
-  myHeader.compressedLength   = reader.compressedSize();
-  myHeader.uncompressedLength = reader.uncompressedSize();
-  myHeader.startDiskNumber    = reader.startDisk();
-  myHeader.localHeaderOffset  = reader.headerOffset();
-  myHeader.filename           = reader.filename();
-
-  // Advance the position
-  myCdPos += reader.totalLength();
-  return &myHeader;
+    const CentralDirEntryReader reader(cd + pos);
+    if(!reader.signatureCorrect() || ((pos + reader.totalLength()) > myEcd.cdSize))
+      throw runtime_error(errorMessage(ZipError::FILE_CORRUPT));
+
+    // Advance the position
+    pos += reader.totalLength();
+
+    // Empty files (and directories) are never used
+    if(reader.uncompressedSize() == 0)
+      continue;
+
+    // Extract file header info
+    ZipHeader header;
+    header.versionCreated     = reader.versionCreated();
+    header.versionNeeded      = reader.versionNeeded();
+    header.bitFlag            = reader.generalFlag();
+    header.compression        = reader.compressionMethod();
+    header.crc                = reader.crc32();
+    header.compressedLength   = reader.compressedSize();
+    header.uncompressedLength = reader.uncompressedSize();
+    header.startDiskNumber    = reader.startDisk();
+    header.localHeaderOffset  = reader.headerOffset();
+    header.filename           = reader.filename();
+
+    // The first file of a given name is used, like with a linear search
+    myIndex.try_emplace(header.filename, myFiles.size());
+    if(Bankswitch::isValidRomName(header.filename))
+      ++myRomfiles;
+
+    myFiles.push_back(std::move(header));
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::decompress(const ByteBuffer& out, uInt64 length)
+void ZipHandler::ZipFile::decompress(const ZipHeader& header,
+                                     const ByteBuffer& out, uInt64 length) const
 {
   // If we don't have enough buffer, error
-  if(length < myHeader.uncompressedLength)
+  if(length < header.uncompressedLength)
     throw runtime_error(errorMessage(ZipError::BUFFER_TOO_SMALL));
 
   // Make sure the info in the header aligns with what we know
-  if(myHeader.startDiskNumber != myEcd.diskNumber)
+  if(header.startDiskNumber != myEcd.diskNumber)
     throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
 
-  // Get the compressed data offset
-  const uInt64 offset = getCompressedDataOffset();
+  // Get the compressed data
+  const uInt8* const data = getCompressedData(header);
 
   // Handle compression types
-  switch(myHeader.compression)
+  switch(header.compression)
   {
     case 0:
-      decompressDataType0(offset, out, length);
+      decompressDataType0(data, header, out);
       break;
 
     case 8:
-      decompressDataType8(offset, out, length);
+      decompressDataType8(data, header, out, length);
       break;
 
     case 14:
@@ -390,56 +517,54 @@ void ZipHandler::ZipFile::decompress(const ByteBuffer& out, uInt64 length)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt64 ZipHandler::ZipFile::getCompressedDataOffset()
+const uInt8* ZipHandler::ZipFile::getCompressedData(const ZipHeader& header) const
 {
   // Don't support a number of features
-  const GeneralFlagReader flags(myHeader.bitFlag);
-  if(myHeader.startDiskNumber != myEcd.diskNumber ||
-     myHeader.versionNeeded > 63 || flags.patchData() ||
+  const GeneralFlagReader flags(header.bitFlag);
+  if(header.startDiskNumber != myEcd.diskNumber ||
+     header.versionNeeded > 63 || flags.patchData() ||
      flags.encrypted() || flags.strongEncryption())
     throw runtime_error(errorMessage(ZipError::UNSUPPORTED));
 
-  // Read the fixed-sized part of the local file header
-  uInt64 read_length = 0;
-  const bool success = readStream(myBuffer, myHeader.localHeaderOffset, 0x1e, read_length);
-  if(!success)
-    throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-  else if(read_length != LocalFileHeaderReader::minimumLength())
+  // Check the fixed-sized part of the local file header
+  if(header.localHeaderOffset + LocalFileHeaderReader::minimumLength() > myLength)
     throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
 
   // Compute the final offset
-  const LocalFileHeaderReader reader(&myBuffer[0]);
+  const LocalFileHeaderReader reader(myData + header.localHeaderOffset);
   if(!reader.signatureCorrect())
     throw runtime_error(errorMessage(ZipError::BAD_SIGNATURE));
 
-  return myHeader.localHeaderOffset + reader.totalLength();
+  const uInt64 offset = header.localHeaderOffset + reader.totalLength();
+  if(offset + header.compressedLength > myLength)
+    throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
+
+  return myData + offset;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::decompressDataType0(
-    uInt64 offset, const ByteBuffer& out, uInt64 length)
+void ZipHandler::ZipFile::decompressDataType0(const uInt8* data,
+    const ZipHeader& header, const ByteBuffer& out)
 {
-  // The data is uncompressed; just read it
-  uInt64 read_length = 0;
-  const bool success = readStream(out, offset, myHeader.compressedLength, read_length);
-  if(!success)
-    throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-  else if(read_length != myHeader.compressedLength)
-    throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
+  // The data is uncompressed; just copy it
+  if(header.compressedLength != header.uncompressedLength)
+    throw runtime_error(errorMessage(ZipError::FILE_CORRUPT));
+
+  std::copy_n(data, header.compressedLength, out.get());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::ZipFile::decompressDataType8(
-    uInt64 offset, const ByteBuffer& out, uInt64 length)
+void ZipHandler::ZipFile::decompressDataType8(const uInt8* data,
+    const ZipHeader& header, const ByteBuffer& out, uInt64 length)
 {
-  uInt64 input_remaining = myHeader.compressedLength;
-
-  // Reset the stream
+  // Reset the stream; the complete input is available, so it can be
+  // inflated in one call
   z_stream stream{};
   stream.zalloc = Z_NULL;
   stream.zfree = Z_NULL;
   stream.opaque = Z_NULL;
-  stream.avail_in = 0;
+  stream.next_in = const_cast<Bytef*>(data);  // NOLINT
+  stream.avail_in = static_cast<uInt32>(header.compressedLength);
   stream.next_out = reinterpret_cast<Bytef *>(out.get());
   stream.avail_out = static_cast<uInt32>(length);
 
@@ -448,45 +573,13 @@ void ZipHandler::ZipFile::decompressDataType8(
   if(zerr != Z_OK)
     throw runtime_error(errorMessage(ZipError::DECOMPRESS_ERROR));
 
-  // Loop until we're done
-  for(;;)
+  // Now inflate
+  zerr = inflate(&stream, Z_FINISH);
+  if(zerr != Z_STREAM_END)
   {
-    // Read in the next chunk of data
-    uInt64 read_length = 0;
-    const bool success = readStream(myBuffer, offset,
-          std::min(input_remaining, static_cast<uInt64>(sizeof(myBuffer.get()))), read_length);
-    if(!success)
-    {
-      inflateEnd(&stream);
-      throw runtime_error(errorMessage(ZipError::FILE_ERROR));
-    }
-    offset += read_length;
-
-    // If we read nothing, but still have data left, the file is truncated
-    if(read_length == 0 && input_remaining > 0)
-    {
-      inflateEnd(&stream);
-      throw runtime_error(errorMessage(ZipError::FILE_TRUNCATED));
-    }
-
-    // Fill out the input data
-    stream.next_in = myBuffer.get();
-    stream.avail_in = static_cast<uInt32>(read_length);
-    input_remaining -= read_length;
-
-    // Add a dummy byte at end of compressed data
-    if(input_remaining == 0)
-      stream.avail_in++;
-
-    // Now inflate
-    zerr = inflate(&stream, Z_NO_FLUSH);
-    if(zerr == Z_STREAM_END)
-      break;
-    else if(zerr != Z_OK)
-    {
-      inflateEnd(&stream);
-      throw runtime_error(errorMessage(ZipError::DECOMPRESS_ERROR));
-    }
+    inflateEnd(&stream);
+    throw runtime_error(errorMessage(zerr == Z_BUF_ERROR && stream.avail_in == 0
+        ? ZipError::FILE_TRUNCATED : ZipError::DECOMPRESS_ERROR));
   }
 
   // Finish decompression
@@ -495,7 +588,7 @@ void ZipHandler::ZipFile::decompressDataType8(
     throw runtime_error(errorMessage(ZipError::DECOMPRESS_ERROR));
 
   // If anything looks funny, report an error
-  if(stream.avail_out > 0 || input_remaining > 0)
+  if(stream.total_out != header.uncompressedLength)
     throw runtime_error(errorMessage(ZipError::DECOMPRESS_ERROR));
 }
 
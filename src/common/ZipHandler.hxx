@@ -20,7 +20,9 @@
 #ifndef ZIP_HANDLER_HXX
 #define ZIP_HANDLER_HXX
 
+#include <functional>
 #include <tuple>
+#include <unordered_map>
 
 #include "bspf.hxx"
 
@@ -33,6 +35,13 @@
 */
 class ZipHandler
 {
+  public:
+    // Receives the name, contents and size of a decompressed file
+    using DecompressCallback =
+        std::function<void(const string&, const ByteBuffer&, size_t)>;
+    // Decides from the name and size of a file whether to decompress it
+    using DecompressFilter = std::function<bool(const string&, size_t)>;
+
   public:
     ZipHandler() = default;
 
@@ -45,10 +54,21 @@ class ZipHandler
     bool hasNext() const;  // Answer whether there are more files present
     std::tuple<string, size_t> next();  // Get information on next file
 
+    // Select the file with the given name, without iterating over the ZIP file
+    bool find(const string& name);
+
     // Decompress the currently selected file and return its length
     // An exception will be thrown on any errors
     uInt64 decompress(ByteBuffer& image);
 
+    // Decompress all files accepted by the filter, using up to 'numThreads'
+    // threads (0 means one per core)
+    // The callback is called from these threads, and must not throw
+    // Files which can't be decompressed are skipped
+    void decompressAll(const DecompressFilter& filter,
+                       const DecompressCallback& callback,
+                       uInt32 numThreads = 0);
+
     // Answer the number of ROM files (with a valid extension) found
     uInt16 romFiles() const { return myZip ? myZip->myRomfiles : 0; }
 
@@ -97,53 +117,66 @@ class ZipHandler
     };
 
     // Describes an open ZIP file
+    // The file is mapped into memory while open, and its central directory
+    // is kept as an index (also while cached), so files can be looked up by
+    // name and decompressed by several threads at once
     struct ZipFile
     {
       string  myFilename;     // copy of ZIP filename (for caching)
-      fstream myStream;       // C++ fstream file handle
       uInt64  myLength{0};    // length of zip file
       uInt16  myRomfiles{0};  // number of ROM files in central directory
 
       ZipEcd  myEcd;          // end of central directory
 
-      ByteBuffer myCd;        // central directory raw data
-      uInt64    myCdPos{0};   // position in central directory
-      ZipHeader myHeader;     // current file header
+      vector<ZipHeader> myFiles;  // central directory, without empty files
+      std::unordered_map<string, size_t> myIndex;  // filename -> myFiles index
 
-      ByteBuffer myBuffer;    // buffer for decompression
+      const uInt8* myData{nullptr};  // contents of the zip file
+      ByteBuffer myBuffer;           // used when the file can't be mapped
+      void* myFileHandle{nullptr};   // OS handles of the memory mapping
+      void* myMapHandle{nullptr};
 
       /** Constructor */
       explicit ZipFile(const string& filename);
 
-      /** Open the file and set up the internal stream buffer*/
+      /** Destructor */
+      ~ZipFile();
+
+      /** Open the file and map it into memory */
       bool open();
 
-      /** Read the ZIP contents from the internal stream buffer */
+      /** Read the ZIP contents from the mapped file */
       void initialize();
 
-      /** Close previously opened internal stream buffer */
+      /** Unmap previously opened file */
       void close();
 
       /** Read the ECD data */
       void readEcd();
 
-      /** Read data from stream */
-      bool readStream(const ByteBuffer& out, uInt64 offset, uInt64 length, uInt64& actual);
-
-      /** Return the next entry in the ZIP file */
-      const ZipHeader* nextFile();
+      /** Read the central directory into the file index */
+      void readCd();
 
-      /** Decompress the most recently found file in the ZIP into target buffer */
-      void decompress(const ByteBuffer& out, uInt64 length);
+      /** Decompress the given file in the ZIP into target buffer */
+      void decompress(const ZipHeader& header, const ByteBuffer& out,
+                      uInt64 length) const;
 
-      /** Return the offset of the compressed data */
-      uInt64 getCompressedDataOffset();
+      /** Return the compressed data of the given file */
+      const uInt8* getCompressedData(const ZipHeader& header) const;
 
       /** Decompress type 0 data (which is uncompressed) */
-      void decompressDataType0(uInt64 offset, const ByteBuffer& out, uInt64 length);
+      static void decompressDataType0(const uInt8* data, const ZipHeader& header,
+                                      const ByteBuffer& out);
 
       /** Decompress type 8 data (which is deflated) */
-      void decompressDataType8(uInt64 offset, const ByteBuffer& out, uInt64 length);
+      static void decompressDataType8(const uInt8* data, const ZipHeader& header,
+                                      const ByteBuffer& out, uInt64 length);
+
+      // Following constructors and assignment operators not supported
+      ZipFile(const ZipFile&) = delete;
+      ZipFile(ZipFile&&) = delete;
+      ZipFile& operator=(const ZipFile&) = delete;
+      ZipFile& operator=(ZipFile&&) = delete;
     };
     using ZipFilePtr = unique_ptr<ZipFile>;
 
@@ -299,10 +332,11 @@ class ZipHandler
     void addToCache();
 
   private:
-    static constexpr size_t DECOMPRESS_BUFSIZE = 128_KB;
     static constexpr size_t CACHE_SIZE = 64; // number of open files to cache
 
     ZipFilePtr myZip;
+    size_t myPos{0};      // iterator position in the central directory
+    size_t myCurrent{0};  // currently selected file
     std::array<ZipFilePtr, CACHE_SIZE> myZipCache;
 
   private:
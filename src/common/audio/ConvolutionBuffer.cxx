@@ -15,31 +15,83 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #include <cstring>
+  #define CONVOLUTION_SSE2
+#endif
+
 #include "ConvolutionBuffer.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-ConvolutionBuffer::ConvolutionBuffer(uInt32 size)
-  : myData{make_unique<float[]>(size)},
-    mySize{size}
+ConvolutionBuffer::ConvolutionBuffer(uInt32 size, uInt32 channels)
+  : myData{make_unique<float[]>(static_cast<size_t>(size) * channels * 2)},
+    mySize{size},
+    myChannels{channels}
 {
-  std::fill_n(myData.get(), mySize, 0.F);
+  std::fill_n(myData.get(), static_cast<size_t>(mySize) * myChannels * 2, 0.F);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ConvolutionBuffer::shift(float nextValue)
 {
-  myData[myFirstIndex] = nextValue;
-  myFirstIndex = (myFirstIndex + 1) % mySize;
+  myData[myFirstIndex] = myData[myFirstIndex + mySize] = nextValue;
+
+  if (++myFirstIndex == mySize) myFirstIndex = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConvolutionBuffer::shift(float nextValueL, float nextValueR)
+{
+  float* data = myData.get() + 2 * static_cast<size_t>(myFirstIndex);
+
+  data[0] = data[2 * mySize] = nextValueL;
+  data[1] = data[2 * mySize + 1] = nextValueR;
+
+  if (++myFirstIndex == mySize) myFirstIndex = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 float ConvolutionBuffer::convoluteWith(const float* const kernel) const
 {
+  const float* data = myData.get() + myFirstIndex;
   float result = 0.F;
 
   for (uInt32 i = 0; i < mySize; ++i) {
-    result += kernel[i] * myData[(myFirstIndex + i) % mySize];
+    result += kernel[i] * data[i];
   }
 
   return result;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ConvolutionBuffer::convoluteWith(const float* const kernel, float& resultL, float& resultR) const
+{
+  const float* data = myData.get() + 2 * static_cast<size_t>(myFirstIndex);
+
+#ifdef CONVOLUTION_SSE2
+  // Both channels are processed in parallel; each lane sums in the same order
+  // as the scalar loop below.
+  __m128 result = _mm_setzero_ps();
+
+  for (uInt32 i = 0; i < mySize; ++i) {
+    // Load the sample pair through memcpy, which avoids type punning and still
+    // compiles to a single 64 bit load
+    double pair;
+    std::memcpy(&pair, data + 2 * i, sizeof(pair));
+
+    const __m128 samples = _mm_castpd_ps(_mm_load_sd(&pair));
+    result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(kernel[i]), samples));
+  }
+
+  resultL = _mm_cvtss_f32(result);
+  resultR = _mm_cvtss_f32(_mm_shuffle_ps(result, result, _MM_SHUFFLE(1, 1, 1, 1)));
+#else
+  resultL = resultR = 0.F;
+
+  for (uInt32 i = 0; i < mySize; ++i) {
+    resultL += kernel[i] * data[2 * i];
+    resultR += kernel[i] * data[2 * i + 1];
+  }
+#endif
+}
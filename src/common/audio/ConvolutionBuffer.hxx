@@ -20,16 +20,30 @@
 
 #include "bspf.hxx"
 
+/**
+  A ring buffer of the last 'size' samples of one or two (interleaved)
+  channels that can be convoluted with a kernel of the same size.
+
+  The samples are stored twice in consecutive memory, so the window of
+  the last 'size' samples is always contiguous and no index wrapping is
+  required during convolution. Products are summed in the same order as
+  a naive loop over the window, so all implementations (scalar and SIMD)
+  produce bit identical results.
+*/
 class ConvolutionBuffer
 {
   public:
 
-    explicit ConvolutionBuffer(uInt32 size);
+    explicit ConvolutionBuffer(uInt32 size, uInt32 channels = 1);
 
     void shift(float nextValue);
 
+    void shift(float nextValueL, float nextValueR);
+
     float convoluteWith(const float* const kernel) const;
 
+    void convoluteWith(const float* const kernel, float& resultL, float& resultR) const;
+
   private:
 
     unique_ptr<float[]> myData;
@@ -38,6 +52,8 @@ class ConvolutionBuffer
 
     uInt32 mySize{0};
 
+    uInt32 myChannels{1};
+
   private:
 
     ConvolutionBuffer() = delete;
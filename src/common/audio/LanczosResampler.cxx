@@ -79,13 +79,7 @@ LanczosResampler::LanczosResampler(
   myPrecomputedKernels = make_unique<float[]>(
       static_cast<size_t>(myPrecomputedKernelCount) * myKernelSize);
 
-  if (myFormatFrom.stereo)
-  {
-    myBufferL = make_unique<ConvolutionBuffer>(myKernelSize);
-    myBufferR = make_unique<ConvolutionBuffer>(myKernelSize);
-  }
-  else
-    myBuffer = make_unique<ConvolutionBuffer>(myKernelSize);
+  myBuffer = make_unique<ConvolutionBuffer>(myKernelSize, myFormatFrom.stereo ? 2 : 1);
 
   precomputeKernels();
 }
@@ -150,8 +144,8 @@ void LanczosResampler::fillFragment(float* fragment, uInt32 length)
     myCurrentKernelIndex = (myCurrentKernelIndex + 1) % myPrecomputedKernelCount;
 
     if (myFormatFrom.stereo) {
-      const float sampleL = myBufferL->convoluteWith(kernel);
-      const float sampleR = myBufferR->convoluteWith(kernel);
+      float sampleL = 0.F, sampleR = 0.F;
+      myBuffer->convoluteWith(kernel, sampleL, sampleR);
 
       if (myFormatTo.stereo) {
         fragment[2*i] = sampleL;
@@ -183,11 +177,10 @@ FORCE_INLINE void LanczosResampler::shiftSamples(uInt32 samplesToShift)
 {
   while (samplesToShift-- > 0) {
     if (myFormatFrom.stereo) {
-      myBufferL->shift(myHighPassL.apply(
-        myCurrentFragment[2 * static_cast<size_t>(myFragmentIndex)] /
-            static_cast<float>(0x7fff)));
-      myBufferR->shift(myHighPassR.apply(
-        myCurrentFragment[2 * static_cast<size_t>(myFragmentIndex) + 1] /
+      myBuffer->shift(
+        myHighPassL.apply(myCurrentFragment[2 * static_cast<size_t>(myFragmentIndex)] /
+            static_cast<float>(0x7fff)),
+        myHighPassR.apply(myCurrentFragment[2 * static_cast<size_t>(myFragmentIndex) + 1] /
             static_cast<float>(0x7fff)));
     }
     else
@@ -50,9 +50,8 @@ class LanczosResampler : public Resampler
 
     uInt32 myKernelParameter{0};
 
+    // Holds both channels (interleaved) for stereo input
     unique_ptr<ConvolutionBuffer> myBuffer;
-    unique_ptr<ConvolutionBuffer> myBufferL;
-    unique_ptr<ConvolutionBuffer> myBufferR;
 
     Int16* myCurrentFragment{nullptr};
     uInt32 myFragmentIndex{0};
@@ -70,7 +70,7 @@ void checkForCustomBaseDir(Settings::Options& options);
 
 /**
   Checks whether the commandline contains an argument corresponding to
-  starting a profile session.
+  starting a profile or benchmark session.
 */
 bool isProfilingRun(int ac, char* av[]);
 
@@ -159,7 +159,7 @@ void checkForCustomBaseDir(Settings::Options& options)
 bool isProfilingRun(int ac, char* av[]) {
   if (ac <= 1) return false;
 
-  return string(av[1]) == "-profile";
+  return string(av[1]) == "-profile" || string(av[1]) == "-benchmark";
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
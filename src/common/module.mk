@@ -25,6 +25,7 @@ MODULE_OBJS := \
 	src/common/PKeyboardHandler.o \
 	src/common/PNGLibrary.o \
 	src/common/RewindManager.o \
+	src/common/RomIndexer.o \
 	src/common/SoundSDL2.o \
 	src/common/StaggeredLogger.o \
 	src/common/StateManager.o \
@@ -39,6 +40,7 @@ MODULE_OBJS := \
 	src/common/repository/KeyValueRepositoryJsonFile.o \
 	src/common/repository/KeyValueRepositoryConfigfile.o \
 	src/common/repository/CompositeKVRJsonAdapter.o \
+	src/common/repository/KeyValueRepositoryCached.o \
 	src/common/repository/CompositeKeyValueRepository.o
 
 MODULE_DIRS += \
@@ -0,0 +1,203 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2023 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include "KeyValueRepositoryCached.hxx"
+#include "Logger.hxx"
+
+namespace {
+  // Changes arriving within this time are written in one batch
+  constexpr auto WRITE_DELAY = std::chrono::milliseconds(500);
+} // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+KeyValueRepositoryCached::KeyValueRepositoryCached(
+    unique_ptr<KeyValueRepositoryAtomic> kvr, string_view name)
+  : myKvr{std::move(kvr)},
+    myName{name}
+{
+  myThread = std::thread([this]{ threadMain(); });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+KeyValueRepositoryCached::~KeyValueRepositoryCached()
+{
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+    myQuit = true;
+  }
+  myCondition.notify_all();
+  myThread.join();
+
+  writePending();
+
+  ostringstream buf;
+  buf << "Repository cache '" << myName << "': " << myHits << " hits, "
+      << myMisses << " misses";
+  Logger::debug(buf.str());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+KVRMap KeyValueRepositoryCached::load()
+{
+  const std::lock_guard<std::mutex> kvrLock(myKvrMutex);
+  const KVRMap values = myKvr->load();
+
+  // Cached entries are never older than those in the backing repository
+  const std::lock_guard<std::mutex> lock(myMutex);
+  for(const auto& [key, value]: values)
+    myCache.try_emplace(key, value.toString());
+  myCacheComplete = true;
+
+  KVRMap result;
+  for(const auto& [key, entry]: myCache)
+    if(entry)
+      result.emplace(key, *entry);
+
+  return result;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool KeyValueRepositoryCached::save(const KVRMap& values)
+{
+  for(const auto& [key, value]: values)
+    store(key, value.toString());
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool KeyValueRepositoryCached::has(string_view key)
+{
+  return lookup(key).has_value();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool KeyValueRepositoryCached::get(string_view key, Variant& value)
+{
+  const Entry entry = lookup(key);
+  if(!entry)
+    return false;
+
+  value = *entry;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool KeyValueRepositoryCached::save(string_view key, const Variant& value)
+{
+  store(key, value.toString());
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositoryCached::remove(string_view key)
+{
+  store(key, std::nullopt);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositoryCached::flush()
+{
+  writePending();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+KeyValueRepositoryCached::Entry KeyValueRepositoryCached::lookup(string_view key)
+{
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+    const auto it = myCache.find(key);
+    if(it != myCache.end())
+    {
+      ++myHits;
+      return it->second;
+    }
+    if(myCacheComplete)
+    {
+      ++myHits;
+      return std::nullopt;
+    }
+  }
+
+  // Note that a single 'get' answers both 'has' and 'get' of the key
+  ++myMisses;
+  const std::lock_guard<std::mutex> kvrLock(myKvrMutex);
+  Variant value;
+  const Entry entry = myKvr->get(key, value) ? Entry{value.toString()} : std::nullopt;
+
+  // The key may have been changed in the meantime, which takes precedence
+  const std::lock_guard<std::mutex> lock(myMutex);
+  return myCache.try_emplace(string{key}, entry).first->second;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositoryCached::store(string_view key, Entry entry)
+{
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+    myCache.insert_or_assign(string{key}, entry);
+    myPending.insert_or_assign(string{key}, std::move(entry));
+  }
+  myCondition.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositoryCached::writePending()
+{
+  // Holding the repository lock while taking the pending changes ensures
+  // that the batches are written in order
+  const std::lock_guard<std::mutex> kvrLock(myKvrMutex);
+  EntryMap pending;
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+    pending.swap(myPending);
+  }
+  if(pending.empty())
+    return;
+
+  KVRMap values;
+  for(auto& [key, entry]: pending)
+  {
+    if(entry)
+      values.emplace(key, std::move(*entry));
+    else
+      myKvr->remove(key);
+  }
+  if(!values.empty())
+    myKvr->save(values);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void KeyValueRepositoryCached::threadMain()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+  while(!myQuit)
+  {
+    myCondition.wait(lock, [this]{ return myQuit || !myPending.empty(); });
+    if(myQuit)
+      break;
+
+    // Give further changes a chance to arrive before writing the batch
+    myCondition.wait_for(lock, WRITE_DELAY, [this]{ return myQuit; });
+
+    lock.unlock();
+    writePending();
+    lock.lock();
+  }
+}
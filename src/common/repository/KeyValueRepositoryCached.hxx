@@ -0,0 +1,111 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2023 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#ifndef KEY_VALUE_REPOSITORY_CACHED_HXX
+#define KEY_VALUE_REPOSITORY_CACHED_HXX
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "KeyValueRepository.hxx"
+#include "bspf.hxx"
+
+/**
+  An in-memory read-through and write-behind cache in front of another
+  (sqlite based) repository.
+
+  Each key is read from the backing repository at most once, and this
+  includes keys which don't exist there.  Changes are applied to the
+  cache immediately, and written to the backing repository in batches by
+  a background thread.  Remaining changes are written on destruction.
+*/
+class KeyValueRepositoryCached : public KeyValueRepositoryAtomic
+{
+  public:
+    KeyValueRepositoryCached(unique_ptr<KeyValueRepositoryAtomic> kvr,
+                             string_view name);
+    ~KeyValueRepositoryCached() override;
+
+    KVRMap load() override;
+
+    bool save(const KVRMap& values) override;
+
+    bool has(string_view key) override;
+
+    bool get(string_view key, Variant& value) override;
+
+    bool save(string_view key, const Variant& value) override;
+
+    void remove(string_view key) override;
+
+    /**
+      Write all pending changes to the backing repository now.
+    */
+    void flush();
+
+    uInt64 hits() const   { return myHits; }
+    uInt64 misses() const { return myMisses; }
+
+  private:
+    // A cached value, or 'nullopt' if the key doesn't exist
+    using Entry = std::optional<string>;
+    using EntryMap = std::map<string, Entry, std::less<>>;
+
+    // Get the entry for the key, reading it from the backing repository
+    // on a cache miss
+    Entry lookup(string_view key);
+
+    // Change the entry for the key, and queue it for writing
+    void store(string_view key, Entry entry);
+
+    // Write the queued changes to the backing repository
+    void writePending();
+
+    void threadMain();
+
+  private:
+    unique_ptr<KeyValueRepositoryAtomic> myKvr;
+    string myName;
+
+    EntryMap myCache;
+    EntryMap myPending;
+    bool myCacheComplete{false};  // all keys are cached (after 'load')
+
+    // Lock order is 'myKvrMutex' before 'myMutex'; the former serializes
+    // all accesses to the backing repository, the latter protects the maps
+    std::mutex myKvrMutex;
+    std::mutex myMutex;
+    std::condition_variable myCondition;
+    bool myQuit{false};
+    std::thread myThread;
+
+    std::atomic<uInt64> myHits{0}, myMisses{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    KeyValueRepositoryCached() = delete;
+    KeyValueRepositoryCached(const KeyValueRepositoryCached&) = delete;
+    KeyValueRepositoryCached(KeyValueRepositoryCached&&) = delete;
+    KeyValueRepositoryCached& operator=(const KeyValueRepositoryCached&) = delete;
+    KeyValueRepositoryCached& operator=(KeyValueRepositoryCached&&) = delete;
+};
+
+#endif // KEY_VALUE_REPOSITORY_CACHED_HXX
@@ -18,6 +18,7 @@
 #ifndef SQLITE_DATABASE_HXX
 #define SQLITE_DATABASE_HXX
 
+#include <mutex>
 #include <sqlite3.h>
 
 #include "bspf.hxx"
@@ -36,6 +37,8 @@ class SqliteDatabase
 
     operator sqlite3*() const { return myHandle; }
 
+    std::recursive_mutex& transactionMutex() { return myTransactionMutex; }
+
     void exec(string_view sql);
 
     template<class T, class ...Ts>
@@ -50,6 +53,8 @@ class SqliteDatabase
 
     sqlite3* myHandle{nullptr};
 
+    std::recursive_mutex myTransactionMutex;
+
   private:
 
     SqliteDatabase(const SqliteDatabase&) = delete;
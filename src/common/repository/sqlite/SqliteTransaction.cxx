@@ -20,9 +20,11 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 SqliteTransaction::SqliteTransaction(SqliteDatabase& db)
-  : myDb{db}
+  : myDb{db},
+    myLock{db.transactionMutex()}
 {
-  if (sqlite3_get_autocommit(db)) {
+  // Nested transactions become part of the outer one
+  if (!sqlite3_get_autocommit(db)) {
     myTransactionClosed = true;
     return;
   }
@@ -18,6 +18,8 @@
 #ifndef SQLITE_TRANSACTION_HXX
 #define SQLITE_TRANSACTION_HXX
 
+#include <mutex>
+
 class SqliteDatabase;
 
 class SqliteTransaction {
@@ -35,6 +37,9 @@ class SqliteTransaction {
 
     SqliteDatabase& myDb;
 
+    // Only one thread at a time may have a transaction on the database
+    std::unique_lock<std::recursive_mutex> myLock;
+
     bool myTransactionClosed{false};
 
   private:
@@ -20,6 +20,7 @@
 #include "StellaDb.hxx"
 #include "Logger.hxx"
 #include "SqliteError.hxx"
+#include "repository/KeyValueRepositoryCached.hxx"
 #include "repository/KeyValueRepositoryNoop.hxx"
 #include "repository/CompositeKeyValueRepositoryNoop.hxx"
 #include "repository/CompositeKVRJsonAdapter.hxx"
@@ -54,16 +55,20 @@ void StellaDb::initialize()
 
     auto settingsRepository = make_unique<KeyValueRepositorySqlite>(*myDb, "settings", "setting", "value");
     settingsRepository->initialize();
-    mySettingsRepository = std::move(settingsRepository);
+    mySettingsRepository = make_unique<KeyValueRepositoryCached>(std::move(settingsRepository), "settings");
 
     auto propertyRepositoryHost = make_unique<KeyValueRepositorySqlite>(*myDb, "properties", "md5", "properties");
     propertyRepositoryHost->initialize();
-    myPropertyRepositoryHost = std::move(propertyRepositoryHost);
+    myPropertyRepositoryHost = make_unique<KeyValueRepositoryCached>(std::move(propertyRepositoryHost), "properties");
 
     auto highscoreRepository = make_unique<CompositeKeyValueRepositorySqlite>(*myDb, "highscores", "md5", "variation", "highscore_data");
     highscoreRepository->initialize();
     myHighscoreRepository = std::move(highscoreRepository);
 
+    auto romIndexRepository = make_unique<KeyValueRepositorySqlite>(*myDb, "romindex", "path", "data");
+    romIndexRepository->initialize();
+    myRomIndexRepository = std::move(romIndexRepository);
+
     myPropertyRepository = make_unique<CompositeKVRJsonAdapter>(*myPropertyRepositoryHost);
 
     if (myDb->getUserVersion() == 0) {
@@ -78,6 +83,7 @@ void StellaDb::initialize()
     mySettingsRepository = make_unique<KeyValueRepositoryNoop>();
     myPropertyRepository = make_unique<CompositeKeyValueRepositoryNoop>();
     myHighscoreRepository = make_unique<CompositeKeyValueRepositoryNoop>();
+    myRomIndexRepository = make_unique<KeyValueRepositoryNoop>();
 
     myDb.reset();
     myPropertyRepositoryHost.reset();
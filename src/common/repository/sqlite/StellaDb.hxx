@@ -40,6 +40,9 @@ class StellaDb
     CompositeKeyValueRepositoryAtomic& highscoreRepository() const {
       return *myHighscoreRepository;
     }
+    KeyValueRepositoryAtomic& romIndexRepository() const {
+      return *myRomIndexRepository;
+    }
 
     string databaseFileName() const;
 
@@ -63,6 +66,7 @@ class StellaDb
     unique_ptr<KeyValueRepositoryAtomic> myPropertyRepositoryHost;
     unique_ptr<CompositeKeyValueRepository> myPropertyRepository;
     unique_ptr<CompositeKeyValueRepositoryAtomic> myHighscoreRepository;
+    unique_ptr<KeyValueRepositoryAtomic> myRomIndexRepository;
 };
 
 #endif // STELLA_DB_HXX
@@ -15,6 +15,7 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <chrono>
 #include <thread>
 #include "AtariNTSC.hxx"
 #include "PhosphorHandler.hxx"
@@ -82,6 +83,8 @@ void AtariNTSC::generateKernels()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::enableThreading(bool enable)
 {
+  stopThreads();
+
   uInt32 systemThreads = enable ? std::thread::hardware_concurrency() : 0;
   if(systemThreads <= 1)
   {
@@ -95,7 +98,69 @@ void AtariNTSC::enableThreading(bool enable)
     myWorkerThreads = systemThreads - 1;
     myTotalThreads  = systemThreads;
 
-    myThreads = make_unique<std::thread[]>(myWorkerThreads);  // NOLINT
+    startThreads();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::startThreads()
+{
+  if(myWorkerThreads == 0)
+    return;
+
+  // The threads must start waiting for the *next* frame
+  const uInt32 generation = myGeneration;
+
+  myQuitThreads = false;
+  myThreads = make_unique<std::thread[]>(myWorkerThreads);  // NOLINT
+  for(uInt32 i = 0; i < myWorkerThreads; ++i)
+    myThreads[i] = std::thread([this, i, generation] {
+      workerThread(i + 1, generation);
+    });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::stopThreads()
+{
+  if(!myThreads)
+    return;
+
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+    myQuitThreads = true;
+  }
+  myFrameStarted.notify_all();
+
+  for(uInt32 i = 0; i < myWorkerThreads; ++i)
+    myThreads[i].join();
+
+  myThreads.reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::workerThread(uInt32 threadNum, uInt32 generation)
+{
+  for(;;)
+  {
+    {
+      std::unique_lock<std::mutex> lock(myMutex);
+      myFrameStarted.wait(lock, [&] {
+        return myQuitThreads || myGeneration != generation;
+      });
+
+      if(myQuitThreads)
+        return;
+
+      generation = myGeneration;
+    }
+
+    renderBand(threadNum);
+
+    {
+      const std::lock_guard<std::mutex> lock(myMutex);
+      if(--myPendingThreads == 0)
+        myFrameFinished.notify_one();
+    }
   }
 }
 
@@ -104,26 +169,49 @@ void AtariNTSC::render(const uInt8* atari_in, const uInt32 in_width,
                        const uInt32 in_height, void* rgb_out,
                        const uInt32 out_pitch, uInt32* rgb_in)
 {
-  // Spawn the threads...
-  for(uInt32 i = 0; i < myWorkerThreads; ++i)
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  myJob = { atari_in, in_width, in_height, rgb_out, out_pitch, rgb_in };
+
+  // Release the waiting threads...
+  if(myWorkerThreads > 0)
   {
-    myThreads[i] = std::thread([=] {
-    rgb_in == nullptr ?
-      renderThread(atari_in, in_width, in_height, myTotalThreads, i+1, rgb_out, out_pitch) :
-      renderWithPhosphorThread(atari_in, in_width, in_height, myTotalThreads, i+1, rgb_in, rgb_out, out_pitch);
-    });
+    {
+      const std::lock_guard<std::mutex> lock(myMutex);
+      myPendingThreads = myWorkerThreads;
+      ++myGeneration;
+    }
+    myFrameStarted.notify_all();
   }
   // Make the main thread busy too
-  rgb_in == nullptr ?
-    renderThread(atari_in, in_width, in_height, myTotalThreads, 0, rgb_out, out_pitch) :
-    renderWithPhosphorThread(atari_in, in_width, in_height, myTotalThreads, 0, rgb_in, rgb_out, out_pitch);
-  // ...and make them join again
-  for(uInt32 i = 0; i < myWorkerThreads; ++i)
-    myThreads[i].join();
+  renderBand(0);
+  // ...and wait until they are finished
+  if(myWorkerThreads > 0)
+  {
+    std::unique_lock<std::mutex> lock(myMutex);
+    myFrameFinished.wait(lock, [&] { return myPendingThreads == 0; });
+  }
 
   // Copy phosphor values into out buffer
   if(rgb_in != nullptr)
     memcpy(rgb_out, rgb_in, static_cast<size_t>(in_height) * out_pitch);
+
+  const std::chrono::duration<float, std::milli> frameTime =
+    std::chrono::high_resolution_clock::now() - start;
+  myRenderTime = myRenderTime * 0.9F + frameTime.count() * 0.1F;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::renderBand(uInt32 threadNum)
+{
+  const RenderJob& job = myJob;
+
+  job.rgb_in == nullptr ?
+    renderThread(job.atari_in, job.in_width, job.in_height, myTotalThreads,
+                 threadNum, job.rgb_out, job.out_pitch) :
+    renderWithPhosphorThread(job.atari_in, job.in_width, job.in_height,
+                             myTotalThreads, threadNum, job.rgb_in,
+                             job.rgb_out, job.out_pitch);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -42,6 +42,8 @@
 
 #include <cmath>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "FrameBufferConstants.hxx"
 #include "bspf.hxx"
@@ -51,6 +53,7 @@ class AtariNTSC
   public:
     // By default, threading is turned off and palette is blank
     AtariNTSC() { enableThreading(false); myRGBPalette.fill(0); }
+    ~AtariNTSC() { stopThreads(); }
 
     // Image parameters, ranging from -1.0 to 1.0. Actual internal values shown
     // in parenthesis and should remain fairly stable in future versions.
@@ -87,7 +90,8 @@ class AtariNTSC
     // Set palette for normal Blarrg mode
     void setPalette(const PaletteArray& palette);
 
-    // Set up threading
+    // Set up threading; the rendering threads are kept alive until
+    // threading is reconfigured or the object is destroyed
     void enableThreading(bool enable);
 
     // Filters one or more rows of pixels. Input pixels are 8-bit Atari
@@ -104,10 +108,25 @@ class AtariNTSC
       return ((((in_width) - 1) / PIXEL_in_chunk + 1)* PIXEL_out_chunk) + 8;
     }
 
+    // Time (in milliseconds) used for filtering a frame, averaged over
+    // the last frames
+    float renderTime() const { return myRenderTime; }
+
   private:
     // Generate kernels from raw RGB palette
     void generateKernels();
 
+    // Start/stop the persistent rendering threads
+    void startThreads();
+    void stopThreads();
+
+    // Main loop of each rendering thread; waits for a new frame, renders
+    // its band of rows and reports back
+    void workerThread(uInt32 threadNum, uInt32 generation);
+
+    // Render the band of rows assigned to the given thread number
+    void renderBand(uInt32 threadNum);
+
     // Threaded rendering
     void renderThread(const uInt8* atari_in, const uInt32 in_width,
       const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum, void* rgb_out, const uInt32 out_pitch);
@@ -161,6 +180,28 @@ class AtariNTSC
     // Number of rendering and total threads
     uInt32 myWorkerThreads{0}, myTotalThreads{0};
 
+    // Parameters of the frame currently being rendered
+    struct RenderJob
+    {
+      const uInt8* atari_in{nullptr};
+      uInt32 in_width{0}, in_height{0};
+      void* rgb_out{nullptr};
+      uInt32 out_pitch{0};
+      uInt32* rgb_in{nullptr};
+    };
+    RenderJob myJob;
+
+    // Frame barrier for the rendering threads: a new frame is signalled by
+    // incrementing the generation, each finished thread decrements the
+    // number of pending threads
+    std::mutex myMutex;
+    std::condition_variable myFrameStarted, myFrameFinished;
+    uInt32 myGeneration{0}, myPendingThreads{0};
+    bool myQuitThreads{false};
+
+    // Averaged time used for rendering a frame
+    float myRenderTime{0.F};
+
     struct init_t
     {
       std::array<float, burst_count * 6> to_rgb{0.F};
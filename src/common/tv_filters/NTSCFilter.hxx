@@ -123,6 +123,9 @@ class NTSCFilter
       myNTSC.enableThreading(enable);
     }
 
+    // Averaged time (in milliseconds) used for filtering a frame
+    inline float renderTime() const { return myNTSC.renderTime(); }
+
   private:
     // Convert from atari_ntsc_setup_t values to equivalent adjustables
     static void convertToAdjustable(Adjustable& adjustable,
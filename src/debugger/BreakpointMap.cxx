@@ -25,6 +25,7 @@ void BreakpointMap::add(const Breakpoint& breakpoint, const uInt32 flags)
 
   myInitialized = true;
   myMap[bp] = flags;
+  updateBits();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -44,6 +45,7 @@ void BreakpointMap::erase(const Breakpoint& breakpoint)
 
     myMap.erase(bp13);
   }
+  updateBits();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -79,6 +81,14 @@ uInt32 BreakpointMap::get(uInt16 addr, uInt8 bank) const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool BreakpointMap::check(const Breakpoint& breakpoint) const
 {
+  if(breakpoint.bank != ANY_BANK)
+  {
+    const uInt16 addr13 = breakpoint.addr & ADDRESS_MASK;
+
+    return myAnyBankAddresses[breakpoint.addr] || myAnyBankAddresses[addr13] ||
+      (breakpoint.bank < myBankAddresses.size() && myBankAddresses[breakpoint.bank][addr13]);
+  }
+
   // 16 bit breakpoint
   auto find = myMap.find(breakpoint);
   if(find != myMap.end())
@@ -91,12 +101,6 @@ bool BreakpointMap::check(const Breakpoint& breakpoint) const
   return (find != myMap.end());
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool BreakpointMap::check(const uInt16 addr, const uInt8 bank) const
-{
-  return check(Breakpoint(addr, bank));
-}
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 BreakpointMap::BreakpointList BreakpointMap::getBreakpoints() const
 {
@@ -118,3 +122,26 @@ BreakpointMap::Breakpoint BreakpointMap::convertBreakpoint(
   else
     return Breakpoint(breakpoint.addr & ADDRESS_MASK, breakpoint.bank);
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BreakpointMap::updateBits()
+{
+  myAddresses.reset();
+  myAnyBankAddresses.reset();
+  myBankAddresses.clear();
+
+  for(const auto& item: myMap)
+  {
+    const Breakpoint& bp = item.first;
+
+    myAddresses.set(bp.addr & ADDRESS_MASK);
+    if(bp.bank == ANY_BANK)
+      myAnyBankAddresses.set(bp.addr);
+    else
+    {
+      if(bp.bank >= myBankAddresses.size())
+        myBankAddresses.resize(bp.bank + 1);
+      myBankAddresses[bp.bank].set(bp.addr);
+    }
+  }
+}
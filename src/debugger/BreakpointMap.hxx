@@ -18,6 +18,7 @@
 #ifndef BREAKPOINT_HXX
 #define BREAKPOINT_HXX
 
+#include <bitset>
 #include <unordered_map>
 
 #include "bspf.hxx"
@@ -25,6 +26,10 @@
 /**
   This class handles simple debugger breakpoints.
 
+  Breakpoints and their flags are kept in a map, which is mirrored into
+  bitsets indexed by bank and address.  This allows checking for a
+  breakpoint at every executed instruction without any lookups.
+
   @author  Thomas Jentzsch
 */
 class BreakpointMap
@@ -80,18 +85,29 @@ class BreakpointMap
 
     /** Check if a breakpoint exists */
     bool check(const Breakpoint& breakpoint) const;
-    bool check(const uInt16 addr, const uInt8 bank) const;
+    bool check(const uInt16 addr, const uInt8 bank) const {
+      // quick check for the address in any bank first
+      return myAddresses[addr & ADDRESS_MASK] && check(Breakpoint(addr, bank));
+    }
+
+    /** Check if a breakpoint exists for the address in any bank */
+    bool checkAddress(const uInt16 addr) const {
+      return myAddresses[addr & ADDRESS_MASK];
+    }
 
     /** Returns a sorted list of breakpoints */
     BreakpointList getBreakpoints() const;
 
     /** clear all breakpoints */
-    void clear() { myMap.clear(); }
+    void clear() { myMap.clear(); updateBits(); }
     size_t size() const { return myMap.size(); }
 
   private:
     static Breakpoint convertBreakpoint(const Breakpoint& breakpoint);
 
+    /** Rebuild the bitsets from the breakpoint map */
+    void updateBits();
+
     struct BreakpointHash {
       size_t operator()(const Breakpoint& bp) const {
         return std::hash<uInt64>()(
@@ -101,6 +117,15 @@ class BreakpointMap
     };
 
     std::unordered_map<Breakpoint, uInt32, BreakpointHash> myMap;
+
+    using AddressBits = std::bitset<ADDRESS_MASK + 1>;
+
+    // 13 bit addresses of all breakpoints, regardless of their bank
+    AddressBits myAddresses;
+    // 16 bit addresses of breakpoints valid in any bank
+    std::bitset<0x10000> myAnyBankAddresses;
+    // 13 bit addresses of breakpoints, indexed by bank
+    std::vector<AddressBits> myBankAddresses;
     bool myInitialized{false};
 
     // Following constructors and assignment operators not supported
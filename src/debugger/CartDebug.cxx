@@ -161,25 +161,25 @@ void CartDebug::saveOldState()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int CartDebug::lastReadAddress()
+int CartDebug::lastReadAddress() const
 {
   return mySystem.m6502().lastReadAddress();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int CartDebug::lastWriteAddress()
+int CartDebug::lastWriteAddress() const
 {
   return mySystem.m6502().lastWriteAddress();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int CartDebug::lastReadBaseAddress()
+int CartDebug::lastReadBaseAddress() const
 {
   return mySystem.m6502().lastReadBaseAddress();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int CartDebug::lastWriteBaseAddress()
+int CartDebug::lastWriteBaseAddress() const
 {
   return mySystem.m6502().lastWriteBaseAddress();
 }
@@ -597,7 +597,7 @@ int CartDebug::getBank(uInt16 address)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int CartDebug::getPCBank()
+int CartDebug::getPCBank() const
 {
   return myConsole.cartridge().getBank(myDebugger.cpuDebug().pc());
 }
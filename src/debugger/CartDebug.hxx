@@ -23,7 +23,7 @@ class CartDebugWidget;
 
 // Function type for CartDebug instance methods
 class CartDebug;
-using CartMethod = int (CartDebug::*)();
+using CartMethod = int (CartDebug::*)() const;
 
 #include <map>
 #include <set>
@@ -85,14 +85,14 @@ class CartDebug : public DebuggerSystem
 
 
     // Return the address of the last CPU read
-    int lastReadAddress();
+    int lastReadAddress() const;
     // Return the address of the last CPU write
-    int lastWriteAddress();
+    int lastWriteAddress() const;
 
     // Return the base (= non-mirrored) address of the last CPU read
-    int lastReadBaseAddress();
+    int lastReadBaseAddress() const;
     // Return the base (= non-mirrored) address of the last CPU write
-    int lastWriteBaseAddress();
+    int lastWriteBaseAddress() const;
 
     /**
       Disassemble from the given address and its bank using the Distella disassembler
@@ -182,7 +182,7 @@ class CartDebug : public DebuggerSystem
     int getBank(uInt16 addr);
 
 
-    int getPCBank();
+    int getPCBank() const;
 
     /**
       Get the total number of banks supported by the cartridge.
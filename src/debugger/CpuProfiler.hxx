@@ -0,0 +1,133 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2023 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef CPU_PROFILER_HXX
+#define CPU_PROFILER_HXX
+
+#include "bspf.hxx"
+
+/**
+  Counts the executed instructions and used CPU cycles for each address
+  and bank, and the CPU cycles used on each scanline.  WSYNC halts are not
+  counted as used cycles.
+*/
+class CpuProfiler
+{
+  public:
+    static constexpr uInt32 BANK_SIZE = 0x2000;       // 13 bit addresses
+    static constexpr uInt32 CYCLES_PER_LINE = 76;
+    static constexpr uInt32 MAX_SCANLINES = 512;
+
+    struct Entry
+    {
+      uInt16 address{0};
+      uInt8 bank{0};
+      uInt64 count{0};
+      uInt64 cycles{0};
+    };
+    using EntryList = std::vector<Entry>;
+    using ScanlineCycles = std::array<uInt64, MAX_SCANLINES>;
+
+    CpuProfiler() { reset(); }
+
+    /** Enabling the profiler clears all previously collected data */
+    void enable(bool enable) {
+      myEnabled = enable;
+      if(enable)
+        reset();
+    }
+    inline bool isEnabled() const { return myEnabled; }
+
+    void reset() {
+      myCounts.clear();
+      myCycles.clear();
+      myAddresses.clear();
+      myScanlineCycles.fill(0);
+      myFrames = 0;
+      myLastFrameCycles = 0;
+    }
+
+    /**
+      Add an executed instruction.
+
+      @param bank         The bank the instruction was executed from
+      @param pc           The address of the instruction
+      @param cycles       The CPU cycles used by the instruction
+      @param frameCycles  The CPU cycles since the start of the frame
+    */
+    void add(uInt8 bank, uInt16 pc, uInt32 cycles, uInt32 frameCycles) {
+      const size_t index = bank * BANK_SIZE + (pc & (BANK_SIZE - 1));
+
+      if(index >= myCounts.size())
+      {
+        const size_t size = (bank + 1) * BANK_SIZE;
+
+        myCounts.resize(size);
+        myCycles.resize(size);
+        myAddresses.resize(size);
+      }
+      ++myCounts[index];
+      myCycles[index] += cycles;
+      myAddresses[index] = pc;
+
+      if(frameCycles < myLastFrameCycles)
+        ++myFrames;
+      myLastFrameCycles = frameCycles;
+      myScanlineCycles[std::min(frameCycles / CYCLES_PER_LINE, MAX_SCANLINES - 1)] += cycles;
+    }
+
+    /** Get all profiled addresses, sorted by used cycles */
+    EntryList entries() const {
+      EntryList list;
+
+      for(size_t i = 0; i < myCounts.size(); ++i)
+        if(myCounts[i])
+          list.push_back({myAddresses[i], static_cast<uInt8>(i / BANK_SIZE),
+                          myCounts[i], myCycles[i]});
+
+      std::sort(list.begin(), list.end(), [](const Entry& a, const Entry& b) {
+        return a.cycles > b.cycles;
+      });
+      return list;
+    }
+
+    const ScanlineCycles& scanlineCycles() const { return myScanlineCycles; }
+
+    /** The number of frames started while profiling */
+    uInt32 frames() const { return myFrames; }
+
+  private:
+    bool myEnabled{false};
+
+    // Indexed by bank and 13 bit address
+    vector<uInt64> myCounts;
+    vector<uInt64> myCycles;
+    vector<uInt16> myAddresses;  // last full address
+
+    ScanlineCycles myScanlineCycles;
+    uInt32 myFrames{0};
+    uInt32 myLastFrameCycles{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    CpuProfiler(const CpuProfiler&) = delete;
+    CpuProfiler(CpuProfiler&&) = delete;
+    CpuProfiler& operator=(const CpuProfiler&) = delete;
+    CpuProfiler& operator=(CpuProfiler&&) = delete;
+};
+
+#endif
@@ -37,11 +37,13 @@
 #include "Cart.hxx"
 
 #include "CartDebug.hxx"
+#include "DiStella.hxx"
 #include "CartDebugWidget.hxx"
 #include "CartRamWidget.hxx"
 #include "CpuDebug.hxx"
 #include "RiotDebug.hxx"
 #include "TIADebug.hxx"
+#include "ThumbProfiler.hxx"
 
 #include "TiaInfoWidget.hxx"
 #include "TiaOutputWidget.hxx"
@@ -525,6 +527,241 @@ void Debugger::log(string_view triggerMsg)
   Logger::log(msg.str());
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Debugger::saveTrace(string path)
+{
+  const TraceBuffer& trace = mySystem.m6502().traceBuffer();
+
+  if(!trace.isEnabled())
+    return DebuggerParser::red("trace buffer not enabled");
+
+  stringstream out;
+  out << "     Cycles Bk/Addr Op Disasm          Access    | PS       A  X  Y  SP\n";
+
+  for(size_t i = 0; i < trace.size(); ++i)
+  {
+    const TraceBuffer::Record& r = trace[i];
+    const DiStella::Instruction_tag& inst = DiStella::ourLookup[r.opcode];
+    // The operand is taken from the code bytes, little endian if two bytes
+    const uInt16 value = inst.bytes == 3 ? r.codeBytes : r.codeBytes & 0xff;
+    bool memory = true;
+    ostringstream disasm, access;
+
+    disasm << inst.mnemonic;
+    switch(inst.addr_mode)
+    {
+      case DiStella::AddressingMode::ACCUMULATOR:
+        disasm << " A";
+        memory = false;
+        break;
+
+      case DiStella::AddressingMode::IMMEDIATE:
+        disasm << " #$" << Base::HEX2 << value;
+        memory = false;
+        break;
+
+      case DiStella::AddressingMode::ZERO_PAGE:
+        disasm << " $" << Base::HEX2 << value;
+        break;
+
+      case DiStella::AddressingMode::ZERO_PAGE_X:
+        disasm << " $" << Base::HEX2 << value << ",X";
+        break;
+
+      case DiStella::AddressingMode::ZERO_PAGE_Y:
+        disasm << " $" << Base::HEX2 << value << ",Y";
+        break;
+
+      case DiStella::AddressingMode::ABSOLUTE:
+        disasm << " $" << Base::HEX4 << value;
+        break;
+
+      case DiStella::AddressingMode::ABSOLUTE_X:
+        disasm << " $" << Base::HEX4 << value << ",X";
+        break;
+
+      case DiStella::AddressingMode::ABSOLUTE_Y:
+        disasm << " $" << Base::HEX4 << value << ",Y";
+        break;
+
+      case DiStella::AddressingMode::ABS_INDIRECT:
+        disasm << " ($" << Base::HEX4 << value << ")";
+        break;
+
+      case DiStella::AddressingMode::INDIRECT_X:
+        disasm << " ($" << Base::HEX2 << value << ",X)";
+        break;
+
+      case DiStella::AddressingMode::INDIRECT_Y:
+        disasm << " ($" << Base::HEX2 << value << "),Y";
+        break;
+
+      case DiStella::AddressingMode::RELATIVE:
+        disasm << " $" << Base::HEX4 << (r.pc + 2 + static_cast<Int8>(value));
+        memory = false;
+        break;
+
+      default:
+        memory = false;
+        break;
+    }
+
+    // Jumps access no data; the pointer read by JMP (ind) is shown instead,
+    // and the target is the address of the next record
+    static constexpr uInt8 JSR = 0x20, JMP_ABS = 0x4c, JMP_IND = 0x6c;
+    if(r.opcode == JSR || r.opcode == JMP_ABS || r.opcode == JMP_IND)
+      memory = false;
+
+    if(memory && inst.rw_mode == DiStella::RWMode::WRITE)
+      access << "W " << Base::HEX4 << r.pokeAddress;
+    else if(memory && inst.rw_mode == DiStella::RWMode::READ)
+      access << "R " << Base::HEX4 << r.peekAddress
+             << "=" << Base::HEX2 << static_cast<int>(r.operand);
+
+    out << std::right << std::setw(11) << std::setfill(' ') << std::dec << r.cycles << " "
+        << std::setw(2) << static_cast<int>(r.bank) << "/" << Base::HEX4 << r.pc << " "
+        << Base::HEX2 << static_cast<int>(r.opcode) << " "
+        << std::left << std::setw(16) << std::setfill(' ') << disasm.str()
+        << std::setw(10) << access.str() << "| "
+        << (r.ps & 0x80 ? "N" : "n") << (r.ps & 0x40 ? "V" : "v") << "-"
+        << (r.ps & 0x10 ? "B" : "b") << (r.ps & 0x08 ? "D" : "d")
+        << (r.ps & 0x04 ? "I" : "i") << (r.ps & 0x02 ? "Z" : "z")
+        << (r.ps & 0x01 ? "C" : "c") << " "
+        << Base::HEX2 << static_cast<int>(r.a) << " "
+        << Base::HEX2 << static_cast<int>(r.x) << " "
+        << Base::HEX2 << static_cast<int>(r.y) << " "
+        << Base::HEX2 << static_cast<int>(r.sp) << "\n";
+  }
+
+  try
+  {
+    if(path.empty())
+      path = myOSystem.userDir().getPath()
+        + myConsole.properties().get(PropType::Cart_Name) + ".trace";
+    else
+      // Append default extension when missing
+      if(path.find_last_of('.') == string::npos)
+        path += ".trace";
+
+    const FSNode node(path);
+
+    node.write(out);
+    return "saved " + std::to_string(trace.size()) + " trace records as "
+      + node.getShortPath();
+  }
+  catch(...)
+  {
+  }
+  return DebuggerParser::red("failed to save trace file");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Debugger::profileSummary(uInt32 entries) const
+{
+  const CpuProfiler& profiler = mySystem.m6502().profiler();
+  const CpuProfiler::EntryList list = profiler.entries();
+  uInt64 count = 0, cycles = 0;
+
+  for(const auto& entry: list)
+  {
+    count += entry.count;
+    cycles += entry.cycles;
+  }
+
+  ostringstream buf;
+  buf << std::dec << count << " instructions, " << cycles << " CPU cycles in "
+      << profiler.frames() << " frames";
+  if(cycles == 0)
+    return buf.str();
+
+  buf << "\n  Cycles Bk/Addr Label";
+  for(size_t i = 0; i < list.size() && i < entries; ++i)
+  {
+    const CpuProfiler::Entry& entry = list[i];
+
+    buf << "\n" << std::right << std::setw(7) << std::setfill(' ') << std::fixed
+        << std::setprecision(2) << 100.0 * entry.cycles / cycles << "% "
+        << std::setw(2) << std::dec << static_cast<int>(entry.bank) << "/"
+        << Base::HEX4 << entry.address << " "
+        << myCartDebug->getLabel(entry.address, true, -1, true);
+  }
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Debugger::saveProfile(string path)
+{
+  const CpuProfiler& profiler = mySystem.m6502().profiler();
+  stringstream out;
+
+  out << "Bank,Address,Label,Instructions,Cycles\n";
+  for(const auto& entry: profiler.entries())
+    out << static_cast<int>(entry.bank) << ",$" << Base::HEX4 << entry.address << ","
+        << myCartDebug->getLabel(entry.address, true, -1, true) << ","
+        << std::dec << entry.count << "," << entry.cycles << "\n";
+
+  const CpuProfiler::ScanlineCycles& scanlines = profiler.scanlineCycles();
+  const uInt32 frames = std::max(profiler.frames(), 1U);
+
+  out << "\nScanline,Cycles,Cycles per frame\n";
+  for(size_t i = 0; i < scanlines.size(); ++i)
+    if(scanlines[i])
+      out << i << "," << scanlines[i] << "," << std::fixed << std::setprecision(2)
+          << static_cast<double>(scanlines[i]) / frames << "\n";
+
+  try
+  {
+    if(path.empty())
+      path = myOSystem.userDir().getPath()
+        + myConsole.properties().get(PropType::Cart_Name) + "_profile.csv";
+    else
+      // Append default extension when missing
+      if(path.find_last_of('.') == string::npos)
+        path += ".csv";
+
+    const FSNode node(path);
+
+    node.write(out);
+    return "saved CPU profile as " + node.getShortPath();
+  }
+  catch(...)
+  {
+  }
+  return DebuggerParser::red("failed to save CPU profile file");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string Debugger::saveArmProfile(string path)
+{
+  const ThumbProfiler* profiler = myConsole.cartridge().armProfiler();
+
+  if(profiler == nullptr)
+    return DebuggerParser::red("no ARM cartridge");
+
+  stringstream out;
+  out << profiler->foldedStacks();
+
+  try
+  {
+    if(path.empty())
+      path = myOSystem.userDir().getPath()
+        + myConsole.properties().get(PropType::Cart_Name) + "_arm.folded";
+    else
+      // Append default extension when missing
+      if(path.find_last_of('.') == string::npos)
+        path += ".folded";
+
+    const FSNode node(path);
+
+    node.write(out);
+    return "saved ARM profile as " + node.getShortPath();
+  }
+  catch(...)
+  {
+  }
+  return DebuggerParser::red("failed to save ARM profile file");
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 Debugger::peek(uInt16 addr, Device::AccessFlags flags)
 {
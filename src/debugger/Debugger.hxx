@@ -328,6 +328,16 @@ class Debugger : public DialogContainer
     void clearAllTraps() const;
     void log(string_view triggerMsg);
 
+    // Convert the CPU trace buffer into text and save it
+    string saveTrace(string path = EmptyString);
+
+    // Show the addresses using most CPU cycles, and save all profile data
+    string profileSummary(uInt32 entries = 16) const;
+    string saveProfile(string path = EmptyString);
+
+    // Save the call stacks of the ARM profiler in folded format
+    string saveArmProfile(string path = EmptyString);
+
     // Set a bunch of RAM locations at once
     string setRAM(IntArray& args);
 
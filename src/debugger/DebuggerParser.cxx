@@ -24,6 +24,7 @@
 #include "RiotDebug.hxx"
 #include "ControlLowLevel.hxx"
 #include "TIADebug.hxx"
+#include "ThumbProfiler.hxx"
 #include "TiaOutputWidget.hxx"
 #include "YaccParser.hxx"
 #include "Expression.hxx"
@@ -839,6 +840,37 @@ void DebuggerParser::executeA()
   debugger.cpuDebug().setA(static_cast<uInt8>(args[0]));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "armProfile"
+void DebuggerParser::executeArmProfile()
+{
+  ThumbProfiler* profiler = debugger.myConsole.cartridge().armProfiler();
+
+  if(profiler == nullptr)
+  {
+    commandResult << red("no ARM cartridge");
+    return;
+  }
+  if(argCount == 1)
+  {
+    commandResult << profiler->summary(args[0]);
+    return;
+  }
+
+  const bool enable = !profiler->isEnabled();
+
+  if(enable)
+  {
+    profiler->enable(true);
+    commandResult << "ARM profiler enabled";
+  }
+  else
+  {
+    commandResult << "ARM profiler disabled\n" << profiler->summary();
+    profiler->enable(false);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "aud"
 void DebuggerParser::executeAud()
@@ -1769,6 +1801,30 @@ void DebuggerParser::executeLoadAllStates()
   debugger.loadAllStates();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "loadArmSymbols"
+void DebuggerParser::executeLoadArmSymbols()
+{
+  ThumbProfiler* profiler = debugger.myConsole.cartridge().armProfiler();
+
+  if(profiler == nullptr)
+  {
+    commandResult << red("no ARM cartridge");
+    return;
+  }
+
+  FSNode node(argStrings[0]);
+  if(!node.exists())
+    node = FSNode(debugger.myOSystem.userDir().getPath() + argStrings[0]);
+
+  const size_t symbols = profiler->loadSymbols(node);
+
+  if(symbols)
+    commandResult << "loaded " << symbols << " ARM symbols from " << node.getShortPath();
+  else
+    commandResult << red("no ARM symbols found in " + node.getShortPath());
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "loadConfig"
 void DebuggerParser::executeLoadConfig()
@@ -1852,6 +1908,32 @@ void DebuggerParser::executePrintTimer()
   printTimer(args[0]);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "profile"
+void DebuggerParser::executeProfile()
+{
+  CpuProfiler& profiler = debugger.mySystem.m6502().profiler();
+
+  if(argCount == 1)
+  {
+    commandResult << debugger.profileSummary(args[0]);
+    return;
+  }
+
+  const bool enable = !profiler.isEnabled();
+
+  if(enable)
+  {
+    profiler.enable(true);
+    commandResult << "CPU profiler enabled";
+  }
+  else
+  {
+    commandResult << "CPU profiler disabled\n" << debugger.profileSummary();
+    profiler.enable(false);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "ram"
 void DebuggerParser::executeRam()
@@ -2128,6 +2210,54 @@ void DebuggerParser::executeSaveDisassembly()
     commandResult << debugger.cartDebug().saveDisassembly();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "saveArmProfile"
+void DebuggerParser::executeSaveArmProfile()
+{
+  if(argCount && argStrings[0] == "?")
+  {
+    DebuggerDialog* dlg = debugger.myDialog;
+
+    BrowserDialog::show(dlg, "Save ARM Profile as",
+                        dlg->instance().userDir().getPath() + cartName() + "_arm.folded",
+                        BrowserDialog::Mode::FileSave,
+                        [this, dlg](bool OK, const FSNode& node)
+    {
+      if(OK)
+        dlg->prompt().print(debugger.saveArmProfile(node.getPath()) + '\n');
+      dlg->prompt().printPrompt();
+    });
+    // avoid printing a new prompt
+    commandResult.str("_NO_PROMPT");
+  }
+  else
+    commandResult << debugger.saveArmProfile();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "saveProfile"
+void DebuggerParser::executeSaveProfile()
+{
+  if(argCount && argStrings[0] == "?")
+  {
+    DebuggerDialog* dlg = debugger.myDialog;
+
+    BrowserDialog::show(dlg, "Save CPU Profile as",
+                        dlg->instance().userDir().getPath() + cartName() + "_profile.csv",
+                        BrowserDialog::Mode::FileSave,
+                        [this, dlg](bool OK, const FSNode& node)
+    {
+      if(OK)
+        dlg->prompt().print(debugger.saveProfile(node.getPath()) + '\n');
+      dlg->prompt().printPrompt();
+    });
+    // avoid printing a new prompt
+    commandResult.str("_NO_PROMPT");
+  }
+  else
+    commandResult << debugger.saveProfile();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "saveRom"
 void DebuggerParser::executeSaveRom()
@@ -2196,6 +2326,30 @@ void DebuggerParser::executeSaveSnap()
   debugger.tiaOutput().saveSnapshot(execDepth, execPrefix, argCount == 0);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "saveTrace"
+void DebuggerParser::executeSaveTrace()
+{
+  if(argCount && argStrings[0] == "?")
+  {
+    DebuggerDialog* dlg = debugger.myDialog;
+
+    BrowserDialog::show(dlg, "Save Trace as",
+                        dlg->instance().userDir().getPath() + cartName() + ".trace",
+                        BrowserDialog::Mode::FileSave,
+                        [this, dlg](bool OK, const FSNode& node)
+    {
+      if(OK)
+        dlg->prompt().print(debugger.saveTrace(node.getPath()) + '\n');
+      dlg->prompt().printPrompt();
+    });
+    // avoid printing a new prompt
+    commandResult.str("_NO_PROMPT");
+  }
+  else
+    commandResult << debugger.saveTrace();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "saveAllStates"
 void DebuggerParser::executeSaveAllStates()
@@ -2422,6 +2576,22 @@ void DebuggerParser::executeTrace()
   commandResult << "executed " << dec << debugger.trace() << " cycles";
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// "traceBuffer"
+void DebuggerParser::executeTraceBuffer()
+{
+  TraceBuffer& trace = debugger.mySystem.m6502().traceBuffer();
+
+  if(argCount == 1)
+    trace.resize(static_cast<size_t>(args[0]) * 1024);
+
+  if(trace.isEnabled())
+    commandResult << "trace buffer contains " << dec << trace.size() << " of "
+                  << trace.capacity() << " instructions";
+  else
+    commandResult << "trace buffer disabled";
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // "trap"
 void DebuggerParser::executeTrap()
@@ -2762,6 +2932,18 @@ DebuggerParser::CommandArray DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeA)
   },
 
+  {
+    "armProfile",
+    "Toggle ARM profiler, or show the xx functions using most cycles",
+    "Shows the functions using most cycles when disabled\n"
+    "Example: armProfile, armProfile 20\n"
+    "NOTE: use loadArmSymbols to get function names",
+    false,
+    false,
+    { Parameters::ARG_WORD, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeArmProfile)
+  },
+
   {
     "aud",
     "Mark 'AUD' range in disassembly",
@@ -3341,6 +3523,17 @@ DebuggerParser::CommandArray DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeLoadAllStates)
   },
 
+  {
+    "loadArmSymbols",
+    "Load ARM function symbols from file xx",
+    "Supports ELF files, linker maps and 'nm' output\n"
+    "Example: loadArmSymbols armcode.elf, loadArmSymbols armcode.map",
+    true,
+    false,
+    { Parameters::ARG_FILE, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeLoadArmSymbols)
+  },
+
   {
     "loadState",
     "Load emulator state xx (0-9)",
@@ -3432,6 +3625,18 @@ DebuggerParser::CommandArray DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executePrintTimer)
   },
 
+  {
+    "profile",
+    "Toggle CPU profiler, or show the xx addresses using most cycles",
+    "Shows the addresses using most cycles when disabled\n"
+    "Example: profile, profile 20\n"
+    "NOTE: use saveProfile to save all profile data",
+    false,
+    false,
+    { Parameters::ARG_WORD, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeProfile)
+  },
+
   {
     "ram",
     "Show ZP RAM, or set address xx to yy1 [yy2 ...]",
@@ -3587,6 +3792,29 @@ DebuggerParser::CommandArray DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeSaveDisassembly)
   },
 
+  {
+    "saveArmProfile",
+    "Save the ARM profile as folded stacks [?]",
+    "The file can be used to create flame graphs\n"
+    "Example: saveArmProfile, saveArmProfile ?\n"
+    "NOTE: saves to user dir by default",
+    false,
+    false,
+    { Parameters::ARG_LABEL, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeSaveArmProfile)
+  },
+
+  {
+    "saveProfile",
+    "Save the CPU profile to CSV file [?]",
+    "Example: saveProfile, saveProfile ?\n"
+    "NOTE: saves to user dir by default",
+    false,
+    false,
+    { Parameters::ARG_LABEL, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeSaveProfile)
+  },
+
   {
     "saveRom",
     "Save (possibly patched) ROM to file [?]",
@@ -3620,6 +3848,17 @@ DebuggerParser::CommandArray DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeSaveSnap)
   },
 
+  {
+    "saveTrace",
+    "Save the CPU trace buffer as text file [?]",
+    "Example: saveTrace, saveTrace ?\n"
+    "NOTE: saves to user dir by default",
+    false,
+    false,
+    { Parameters::ARG_LABEL, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeSaveTrace)
+  },
+
   {
     "saveAllStates",
     "Save all emulator states",
@@ -3721,6 +3960,18 @@ DebuggerParser::CommandArray DebuggerParser::commands = { {
     std::mem_fn(&DebuggerParser::executeTrace)
   },
 
+  {
+    "traceBuffer",
+    "Record the last xx K CPU instructions (0 = off)",
+    "Shows the buffer state if no argument is given\n"
+    "Example: traceBuffer, traceBuffer 100, traceBuffer 0\n"
+    "NOTE: use saveTrace to save the recorded instructions",
+    false,
+    false,
+    { Parameters::ARG_WORD, Parameters::ARG_END_ARGS },
+    std::mem_fn(&DebuggerParser::executeTraceBuffer)
+  },
+
   {
     "trap",
     "Trap read/write access to address(es) xx [yy]",
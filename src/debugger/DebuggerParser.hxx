@@ -101,7 +101,7 @@ class DebuggerParser
       std::array<Parameters, 10> parms;
       std::function<void (DebuggerParser*)> executor;
     };
-    using CommandArray = std::array<Command, 110>;
+    using CommandArray = std::array<Command, 117>;
     static CommandArray commands;
 
     struct Trap
@@ -152,6 +152,7 @@ class DebuggerParser
 
     // List of available command methods
     void executeA();
+    void executeArmProfile();
     void executeAud();
     void executeAutoSave();
     void executeBase();
@@ -208,6 +209,7 @@ class DebuggerParser
     void executeListTimers();
     void executeListTraps();
     void executeLoadAllStates();
+    void executeLoadArmSymbols();
     void executeLoadConfig();
     void executeLoadState();
     void executeLogBreaks();
@@ -218,6 +220,7 @@ class DebuggerParser
     void executePGfx();
     void executePrint();
     void executePrintTimer();
+    void executeProfile();
     void executeRam();
     void executeReset();
     void executeResetTimers();
@@ -232,11 +235,14 @@ class DebuggerParser
     void executeSave();
     void executeSaveAccess();
     void executeSaveAllStates();
+    void executeSaveArmProfile();
     void executeSaveConfig();
     void executeSaveDisassembly();
+    void executeSaveProfile();
     void executeSaveRom();
     void executeSaveSes();
     void executeSaveSnap();
+    void executeSaveTrace();
     void executeSaveState();
     void executeSaveStateIf();
     void executeScanLine();
@@ -246,6 +252,7 @@ class DebuggerParser
     void executeTia();
     void executeTimer();
     void executeTrace();
+    void executeTraceBuffer();
     void executeTrap();
     void executeTrapIf();
     void executeTrapRead();
@@ -156,6 +156,7 @@ class DiStella
     CartDebug::AddrTypeArray& myLabels;
     CartDebug::AddrTypeArray& myDirectives;
 
+  public:
     /**
       Enumeration of the 6502 addressing modes
     */
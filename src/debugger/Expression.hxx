@@ -20,6 +20,8 @@
 
 #include "bspf.hxx"
 
+class CompiledExpression;
+
 /**
   This class provides an implementation of an expression node, which
   is a construct that is given two other expressions and evaluates and
@@ -37,6 +39,13 @@ class Expression
 
     virtual Int32 evaluate() const { return 0; }
 
+    /**
+      Append the bytecode for this expression to the given program.
+      By default the node is evaluated as a whole; operators override this
+      to emit their operands and a single instruction instead.
+    */
+    virtual void compile(CompiledExpression& program) const;
+
   protected:
     unique_ptr<Expression> myLHS, myRHS;
 
@@ -50,4 +59,258 @@ class Expression
 
 static const Expression EmptyExpression;
 
+/**
+  An expression tree translated into flat stack machine bytecode.  This is
+  used for conditions which are evaluated for each executed instruction,
+  where walking the tree of virtual nodes is too slow.  Constant
+  subexpressions are folded while compiling.
+
+  The compiled expression takes ownership of the tree, since all nodes
+  which cannot be translated are referenced by the bytecode.
+*/
+class CompiledExpression
+{
+  public:
+    using UnaryFunction = Int32 (*)(Int32);
+    using MethodCall = Int32 (*)(const void* object, const void* method);
+
+    enum class Op: uInt8 {
+      constant,       // push value
+      node,           // push node->evaluate()
+      method,         // push (object->*method)(), e.g. a CPU register
+      function,       // replace top with function(top)
+      andJump,        // if top is 0, jump to value, else pop
+      orJump,         // if top is not 0, replace with 1 and jump to value, else pop
+      // unary operators
+      binNot, logNot, toBool, negate, hiByte, loByte,
+      // binary operators
+      add, sub, mul, div, mod, binAnd, binOr, binXor, shiftLeft, shiftRight,
+      equals, notEquals, less, lessEquals, greater, greaterEquals
+    };
+
+  public:
+    explicit CompiledExpression(Expression* expression)
+      : myExpression{expression}
+    {
+      myExpression->compile(*this);
+      myStack.resize(std::max<size_t>(myMaxDepth, 1));
+    }
+
+    Int32 evaluate() const
+    {
+      // Points behind the top of the stack
+      Int32* sp = myStack.data();
+      const Instruction* const code = myCode.data();
+      const size_t size = myCode.size();
+
+      for(size_t ip = 0; ip < size; ++ip)
+      {
+        const Instruction& inst = code[ip];
+
+        switch(inst.op)
+        {
+          case Op::constant:
+            *sp++ = inst.value;
+            break;
+
+          case Op::node:
+            *sp++ = inst.node->evaluate();
+            break;
+
+          case Op::method:
+            *sp++ = inst.call(inst.object, inst.method);
+            break;
+
+          case Op::function:
+            sp[-1] = inst.function(sp[-1]);
+            break;
+
+          case Op::andJump:
+            if(sp[-1] == 0)
+              ip = static_cast<size_t>(inst.value) - 1;
+            else
+              --sp;
+            break;
+
+          case Op::orJump:
+            if(sp[-1] != 0)
+            {
+              sp[-1] = 1;
+              ip = static_cast<size_t>(inst.value) - 1;
+            }
+            else
+              --sp;
+            break;
+
+          default:
+            if(inst.op <= Op::loByte)
+              sp[-1] = apply(inst.op, sp[-1]);
+            else
+            {
+              --sp;
+              sp[-1] = apply(inst.op, sp[-1], sp[0]);
+            }
+            break;
+        }
+      }
+      return sp[-1];
+    }
+
+    /**
+      Methods used by Expression::compile to build the program.
+    */
+    void emitConstant(Int32 value) {
+      push({Op::constant, value}, 1);
+    }
+
+    void emitNode(const Expression& node) {
+      push({Op::node, 0, &node}, 1);
+    }
+
+    // The member pointer is referenced, so it must live as long as the
+    // program, e.g. in a node of the expression tree
+    template<class T>
+    void emitMethod(const T& object, int (T::* const& method)() const) {
+      push({Op::method, 0, nullptr, nullptr, &object, &method, callMethod<T>}, 1);
+    }
+
+    void emitFunction(UnaryFunction function) {
+      push({Op::function, 0, nullptr, function}, 0);
+    }
+
+    void emitUnary(Op op) {
+      if(lastIsConstant(1))
+        myCode.back().value = apply(op, myCode.back().value);
+      else
+        push({op}, 0);
+    }
+
+    void emitBinary(const Expression& lhs, const Expression& rhs, Op op) {
+      lhs.compile(*this);
+      rhs.compile(*this);
+
+      if(lastIsConstant(2))
+      {
+        const Int32 value = apply(op, myCode[myCode.size() - 2].value, myCode.back().value);
+        myCode.pop_back();
+        myCode.back().value = value;
+        --myDepth;
+      }
+      else
+        push({op}, -1);
+    }
+
+    // Short-circuit '&&' (andJump) and '||' (orJump)
+    void emitLogical(const Expression& lhs, const Expression& rhs, Op op) {
+      lhs.compile(*this);
+
+      if(lastIsConstant(1))
+      {
+        const bool value = myCode.back().value != 0;
+        if(value == (op == Op::orJump))
+        {
+          // Result is already known, the right side is never evaluated
+          myCode.back().value = value;
+          return;
+        }
+        myCode.pop_back();
+        --myDepth;
+        rhs.compile(*this);
+        emitUnary(Op::toBool);
+        return;
+      }
+      const size_t jump = myCode.size();
+      push({op}, -1);
+      rhs.compile(*this);
+      emitUnary(Op::toBool);
+      myCode[jump].value = static_cast<Int32>(myCode.size());
+    }
+
+  private:
+    struct Instruction {
+      Op op{Op::constant};
+      Int32 value{0};                  // constant or jump target
+      const Expression* node{nullptr};
+      UnaryFunction function{nullptr};
+      const void* object{nullptr};     // bound object and member pointer
+      const void* method{nullptr};
+      MethodCall call{nullptr};
+    };
+
+    template<class T>
+    static Int32 callMethod(const void* object, const void* method) {
+      using Method = int (T::*)() const;
+      return (static_cast<const T*>(object)->*(*static_cast<const Method*>(method)))();
+    }
+
+    void push(const Instruction& inst, int depthChange) {
+      myCode.push_back(inst);
+      myDepth += depthChange;
+      myMaxDepth = std::max(myMaxDepth, myDepth);
+    }
+
+    // Check if the last 'count' instructions only push constants and are not
+    // the target of a jump
+    bool lastIsConstant(size_t count) const {
+      if(myCode.size() < count)
+        return false;
+      for(size_t i = myCode.size() - count; i < myCode.size(); ++i)
+        if(myCode[i].op != Op::constant)
+          return false;
+      for(const auto& inst: myCode)
+        if((inst.op == Op::andJump || inst.op == Op::orJump) &&
+            static_cast<size_t>(inst.value) > myCode.size() - count)
+          return false;
+      return true;
+    }
+
+    static Int32 apply(Op op, Int32 value) {
+      switch(op)
+      {
+        case Op::binNot:  return ~value;
+        case Op::logNot:  return !value;
+        case Op::toBool:  return value != 0;
+        case Op::negate:  return -value;
+        case Op::hiByte:  return 0xff & (value >> 8);
+        case Op::loByte:  return 0xff & value;
+        default:          return 0;
+      }
+    }
+
+    static Int32 apply(Op op, Int32 lhs, Int32 rhs) {
+      switch(op)
+      {
+        case Op::add:           return lhs + rhs;
+        case Op::sub:           return lhs - rhs;
+        case Op::mul:           return lhs * rhs;
+        case Op::div:           return rhs == 0 ? 0 : lhs / rhs;
+        case Op::mod:           return rhs == 0 ? 0 : lhs % rhs;
+        case Op::binAnd:        return lhs & rhs;
+        case Op::binOr:         return lhs | rhs;
+        case Op::binXor:        return lhs ^ rhs;
+        case Op::shiftLeft:     return lhs << rhs;
+        case Op::shiftRight:    return lhs >> rhs;
+        case Op::equals:        return lhs == rhs;
+        case Op::notEquals:     return lhs != rhs;
+        case Op::less:          return lhs < rhs;
+        case Op::lessEquals:    return lhs <= rhs;
+        case Op::greater:       return lhs > rhs;
+        case Op::greaterEquals: return lhs >= rhs;
+        default:                return 0;
+      }
+    }
+
+  private:
+    unique_ptr<Expression> myExpression;
+    vector<Instruction> myCode;
+    mutable vector<Int32> myStack;
+    int myDepth{0}, myMaxDepth{0};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline void Expression::compile(CompiledExpression& program) const
+{
+  program.emitNode(*this);
+}
+
 #endif
@@ -0,0 +1,284 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2023 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+
+#include "FSNode.hxx"
+#include "Base.hxx"
+#include "ThumbProfiler.hxx"
+
+using Common::Base;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::enable(bool enable)
+{
+  myEnabled = enable;
+  if(enable)
+    reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::reset()
+{
+  myNodes.clear();
+  myNodeIndex.clear();
+  myBlockCycles.clear();
+  myStack.clear();
+  myRuns = 0;
+
+  // Make sure there is always a frame to account cycles to
+  myStack.push_back({nodeFor(NO_PARENT, 0), NO_RETURN});
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::enterFunction(uInt32 address)
+{
+  myCallPending = false;
+
+  if(myStack.size() < MAX_DEPTH)
+  {
+    const uInt32 node = nodeFor(myStack.back().node, address);
+
+    ++myNodes[node].calls;
+    myStack.push_back({node, myReturnAddress});
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ThumbProfiler::leaveFunction(uInt32 address)
+{
+  // Returns may skip frames (e.g. for tail calls), so search the whole stack
+  for(size_t i = myStack.size() - 1; i > 0; --i)
+    if(myStack[i].returnAddress == address)
+    {
+      myStack.resize(i);
+      break;
+    }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 ThumbProfiler::nodeFor(uInt32 parent, uInt32 function)
+{
+  const uInt64 key = (static_cast<uInt64>(parent) << 32) | function;
+  const auto iter = myNodeIndex.find(key);
+
+  if(iter != myNodeIndex.end())
+    return iter->second;
+
+  const auto node = static_cast<uInt32>(myNodes.size());
+
+  myNodes.push_back({parent, function, 0, 0});
+  myNodeIndex.emplace(key, node);
+
+  return node;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t ThumbProfiler::loadSymbols(const FSNode& node)
+{
+  ByteBuffer buffer;
+  size_t size = 0;
+
+  try
+  {
+    size = node.read(buffer);
+  }
+  catch(...)
+  {
+    return 0;
+  }
+  mySymbols.clear();
+
+  const auto get16 = [&](size_t offset) -> uInt32 {
+    return offset + 2 <= size ? buffer[offset] | (buffer[offset + 1] << 8) : 0;
+  };
+  const auto get32 = [&](size_t offset) -> uInt32 {
+    return offset + 4 <= size ? get16(offset) | (get16(offset + 2) << 16) : 0;
+  };
+
+  if(size > 0x34 && buffer[0] == 0x7f && buffer[1] == 'E' && buffer[2] == 'L' &&
+     buffer[3] == 'F')
+  {
+    // 32 bit little endian ELF file, use the function symbols of all symbol tables
+    constexpr uInt32 SHT_SYMTAB = 2, STT_FUNC = 2;
+
+    if(buffer[4] != 1 || buffer[5] != 1)
+      return 0;
+
+    const uInt32 shOffset = get32(0x20), shSize = get16(0x2e), shNum = get16(0x30);
+
+    for(uInt32 i = 0; i < shNum; ++i)
+    {
+      const size_t section = shOffset + i * shSize;
+
+      if(get32(section + 4) != SHT_SYMTAB)
+        continue;
+
+      const uInt32 symOffset = get32(section + 16), symSize = get32(section + 20);
+      const uInt32 strSection = shOffset + get32(section + 24) * shSize;
+      const uInt32 strOffset = get32(strSection + 16), strSize = get32(strSection + 20);
+
+      for(uInt32 sym = symOffset; sym + 16 <= symOffset + symSize && sym + 16 <= size;
+          sym += 16)
+      {
+        const uInt32 name = get32(sym);
+
+        if((buffer[sym + 12] & 0x0f) != STT_FUNC || name >= strSize ||
+           strOffset + name >= size)
+          continue;
+
+        const char* str = reinterpret_cast<const char*>(&buffer[strOffset + name]);
+        mySymbols[get32(sym + 4) & ~1] =
+          string(str, strnlen(str, std::min<size_t>(strSize - name, size - strOffset - name)));
+      }
+    }
+  }
+  else
+  {
+    // Text file, either a linker map ('0x<address> <symbol>') or the output
+    // of 'nm' ('<address> <type> <symbol>')
+    std::istringstream in(string(reinterpret_cast<const char*>(buffer.get()), size));
+    string line;
+
+    while(std::getline(in, line))
+    {
+      std::istringstream fields(line);
+      vector<string> field;
+      string f;
+
+      while(fields >> f && field.size() < 4)
+        field.push_back(f);
+
+      string address, symbol;
+
+      if(field.size() == 2 && BSPF::startsWithIgnoreCase(field[0], "0x"))
+      {
+        address = field[0].substr(2);
+        symbol = field[1];
+      }
+      else if(field.size() == 3 && field[1].size() == 1 &&
+              string_view("TtWw").find(field[1][0]) != string_view::npos)
+      {
+        address = field[0];
+        symbol = field[2];
+      }
+      if(address.empty() || address.find_first_not_of("0123456789abcdefABCDEF") != string::npos ||
+         !(std::isalpha(symbol[0]) || symbol[0] == '_') ||
+         symbol.find_first_of("=();") != string::npos)
+        continue;
+
+      // ARM addresses have 32 bits, but 'nm' may pad them to 64 bits
+      address.erase(0, std::min(address.find_first_not_of('0'), address.size() - 1));
+      if(address.size() > 8)
+        continue;
+
+      mySymbols[static_cast<uInt32>(std::stoul(address, nullptr, 16)) & ~1] = symbol;
+    }
+  }
+  return mySymbols.size();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string ThumbProfiler::symbolName(uInt32 address, bool offset) const
+{
+  auto iter = mySymbols.upper_bound(address);
+
+  if(iter != mySymbols.begin())
+  {
+    --iter;
+
+    // Assume functions are not larger than 64 KB
+    if(address - iter->first < 0x10000)
+    {
+      ostringstream buf;
+
+      buf << iter->second;
+      if(offset && address != iter->first)
+        buf << "+0x" << std::hex << (address - iter->first);
+      return buf.str();
+    }
+  }
+
+  ostringstream buf;
+  buf << "0x" << Base::HEX8 << address;
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string ThumbProfiler::summary(uInt32 entries) const
+{
+  // Sum up the self cycles per function
+  std::map<uInt32, uInt64> functions;
+  uInt64 total = 0;
+
+  for(const auto& node: myNodes)
+  {
+    functions[node.function] += node.cycles;
+    total += node.cycles;
+  }
+
+  ostringstream buf;
+  buf << std::dec << myRuns << " ARM runs, " << total << " cycles";
+  if(total == 0)
+    return buf.str();
+
+  const auto print = [&](const std::map<uInt32, uInt64>& list, bool blocks)
+  {
+    vector<std::pair<uInt32, uInt64>> sorted(list.begin(), list.end());
+
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+      return a.second > b.second;
+    });
+    for(size_t i = 0; i < sorted.size() && i < entries && sorted[i].second; ++i)
+      buf << "\n" << std::right << std::setw(7) << std::setfill(' ') << std::fixed
+          << std::setprecision(2) << 100.0 * sorted[i].second / total << "% "
+          << Base::HEX8 << sorted[i].first << " "
+          << symbolName(sorted[i].first, blocks);
+  };
+
+  buf << "\nFunctions (self cycles):";
+  print(functions, false);
+
+  buf << "\nBlocks:";
+  print(std::map<uInt32, uInt64>(myBlockCycles.begin(), myBlockCycles.end()), true);
+
+  return buf.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string ThumbProfiler::foldedStacks() const
+{
+  ostringstream buf;
+
+  for(const auto& node: myNodes)
+  {
+    if(node.cycles == 0)
+      continue;
+
+    // Collect the stack from the root
+    vector<uInt32> stack;
+    for(const Node* n = &node; ; n = &myNodes[n->parent])
+    {
+      stack.push_back(n->function);
+      if(n->parent == NO_PARENT)
+        break;
+    }
+    for(auto iter = stack.rbegin(); iter != stack.rend(); ++iter)
+      buf << (iter == stack.rbegin() ? "" : ";") << symbolName(*iter);
+    buf << " " << std::dec << node.cycles << "\n";
+  }
+  return buf.str();
+}
@@ -0,0 +1,153 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2023 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef THUMB_PROFILER_HXX
+#define THUMB_PROFILER_HXX
+
+class FSNode;
+
+#include <map>
+#include <unordered_map>
+
+#include "bspf.hxx"
+
+/**
+  Profiler for the ARM code run by the Thumbulator.  The used ARM cycles
+  are accumulated per basic block and per call stack, with calls and
+  returns inferred from BL/BLX and the branches back to their return
+  addresses.  Function names can be resolved from the symbol table of an
+  ELF file, a linker map file or the output of 'nm'.
+
+  The results can be exported as folded stacks, as used by flame graph
+  tools.
+*/
+class ThumbProfiler
+{
+  public:
+    ThumbProfiler() { reset(); }
+
+    /**
+      Enable or disable the profiler.  Enabling clears all collected data.
+    */
+    void enable(bool enable);
+    bool isEnabled() const { return myEnabled; }
+
+    /**
+      Clear all collected data (but not the symbols).
+    */
+    void reset();
+
+    /**
+      Load function symbols from an ELF file, a linker map file or a
+      symbol list as created by 'nm'.
+
+      @return  The number of symbols loaded
+    */
+    size_t loadSymbols(const FSNode& node);
+
+    /**
+      The following methods are called by the Thumbulator.  The clock is
+      either the ARM cycles or the instructions executed in the current run.
+    */
+    void beginRun(uInt32 address) {
+      myStack.clear();
+      myStack.push_back({nodeFor(NO_PARENT, address), NO_RETURN});
+      myBlock = address;
+      myClock = 0;
+      myCallPending = false;
+      ++myRuns;
+    }
+    void endRun(uInt64 clock) {
+      account(clock);
+    }
+    void enterBlock(uInt32 address, uInt64 clock) {
+      account(clock);
+      if(myCallPending)
+        enterFunction(address);
+      else if(myStack.size() > 1)
+        leaveFunction(address);
+      myBlock = address;
+    }
+    void call(uInt32 returnAddress) {
+      myCallPending = true;
+      myReturnAddress = returnAddress & ~1;
+    }
+
+    /**
+      A summary of the functions and blocks using most cycles.
+    */
+    string summary(uInt32 entries = 10) const;
+
+    /**
+      The call stacks with their cycles in folded format, one stack per line.
+    */
+    string foldedStacks() const;
+
+  private:
+    static constexpr uInt32 NO_PARENT = ~0U, NO_RETURN = ~0U;
+    static constexpr size_t MAX_DEPTH = 256;
+
+    struct Node {
+      uInt32 parent{NO_PARENT};
+      uInt32 function{0};
+      uInt64 cycles{0};  // self cycles
+      uInt64 calls{0};
+    };
+    struct Frame {
+      uInt32 node{0};
+      uInt32 returnAddress{NO_RETURN};
+    };
+
+    void account(uInt64 clock) {
+      const uInt64 cycles = clock - myClock;
+
+      myBlockCycles[myBlock] += cycles;
+      myNodes[myStack.back().node].cycles += cycles;
+      myClock = clock;
+    }
+    void enterFunction(uInt32 address);
+    void leaveFunction(uInt32 address);
+    uInt32 nodeFor(uInt32 parent, uInt32 function);
+
+    // Name of the function containing the address, plus offset if requested
+    string symbolName(uInt32 address, bool offset = false) const;
+
+  private:
+    bool myEnabled{false};
+
+    vector<Node> myNodes;
+    std::unordered_map<uInt64, uInt32> myNodeIndex;  // (parent, function) -> node
+    vector<Frame> myStack;
+    std::unordered_map<uInt32, uInt64> myBlockCycles;
+
+    uInt32 myBlock{0};
+    uInt64 myClock{0};
+    bool myCallPending{false};
+    uInt32 myReturnAddress{0};
+    uInt64 myRuns{0};
+
+    std::map<uInt32, string> mySymbols;
+
+  private:
+    // Following constructors and assignment operators not supported
+    ThumbProfiler(const ThumbProfiler&) = delete;
+    ThumbProfiler(ThumbProfiler&&) = delete;
+    ThumbProfiler& operator=(const ThumbProfiler&) = delete;
+    ThumbProfiler& operator=(ThumbProfiler&&) = delete;
+};
+
+#endif  // THUMB_PROFILER_HXX
@@ -0,0 +1,92 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2023 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef TRACE_BUFFER_HXX
+#define TRACE_BUFFER_HXX
+
+#include "bspf.hxx"
+
+/**
+  A ring buffer of fixed size binary records, one for each instruction
+  executed by the CPU.  Recording is cheap enough to trace many frames;
+  the records are only converted into text when the trace is saved.
+*/
+class TraceBuffer
+{
+  public:
+    struct Record
+    {
+      uInt64 cycles{0};        // system cycles before the instruction
+      uInt16 pc{0};
+      uInt16 peekAddress{0};   // last address read by the instruction
+      uInt16 pokeAddress{0};   // last address written by the instruction
+      uInt16 codeBytes{0};     // the two bytes following the opcode
+      uInt8 bank{0};
+      uInt8 opcode{0};
+      uInt8 operand{0};        // value read by the instruction
+      uInt8 a{0}, x{0}, y{0}, sp{0}, ps{0};  // registers before the instruction
+    };
+
+    TraceBuffer() = default;
+
+    /**
+      Set the number of records, which is rounded up to the next power of
+      two.  A size of zero disables tracing.
+    */
+    void resize(size_t size) {
+      size_t capacity = size ? 1 : 0;
+      while(capacity && capacity < size)
+        capacity <<= 1;
+
+      myRecords.assign(capacity, Record{});
+      myMask = capacity ? capacity - 1 : 0;
+      clear();
+    }
+
+    void clear() { myCount = 0; }
+
+    inline bool isEnabled() const { return !myRecords.empty(); }
+
+    size_t capacity() const { return myRecords.size(); }
+    size_t size() const { return std::min<uInt64>(myCount, myRecords.size()); }
+
+    /**
+      Start a new record, overwriting the oldest one when the buffer is full
+    */
+    Record& next() { return myRecords[myCount++ & myMask]; }
+
+    /**
+      Get a record, where index 0 is the oldest one still in the buffer
+    */
+    const Record& operator[](size_t index) const {
+      return myRecords[(myCount - size() + index) & myMask];
+    }
+
+  private:
+    vector<Record> myRecords;
+    uInt64 myMask{0};
+    uInt64 myCount{0};
+
+  private:
+    // Following constructors and assignment operators not supported
+    TraceBuffer(const TraceBuffer&) = delete;
+    TraceBuffer(TraceBuffer&&) = delete;
+    TraceBuffer& operator=(const TraceBuffer&) = delete;
+    TraceBuffer& operator=(TraceBuffer&&) = delete;
+};
+
+#endif
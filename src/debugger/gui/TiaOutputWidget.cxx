@@ -218,7 +218,13 @@ string TiaOutputWidget::getToolTip(const Common::Point& pos) const
   const uInt32 yStart = height <= FrameManager::Metrics::baseHeightPAL
     ? 0 : (height - FrameManager::Metrics::baseHeightPAL) >> 1;
   const Int32 i = idx.x + (yStart + idx.y) * instance().console().tia().width();
-  const uInt8* tiaOutputBuffer = instance().console().tia().outputBuffer();
+  // Below the beam, the last frame is shown
+  uInt32 scanx = 0, scany = 0;
+  instance().console().tia().electronBeamPos(scanx, scany);
+  const uInt32 scanoffset = instance().console().tia().width() * scany + scanx;
+  const uInt8* tiaOutputBuffer = static_cast<uInt32>(i) >= scanoffset
+    ? instance().console().tia().lastFrameBuffer()
+    : instance().console().tia().outputBuffer();
   ostringstream buf;
 
   buf << _toolTipText
@@ -258,6 +264,8 @@ void TiaOutputWidget::drawWidget(bool hilite)
   const bool visible = instance().console().tia().electronBeamPos(scanx, scany);
   const uInt32 scanoffset = width * scany + scanx;
   const uInt8* tiaOutputBuffer = instance().console().tia().outputBuffer();
+  // Below the beam, the last frame is shown
+  const uInt8* tiaLastFrame = instance().console().tia().lastFrameBuffer();
   const TIASurface& tiaSurface = instance().frameBuffer().tiaSurface();
 
   for(uInt32 y = 0, i = yStart * width; y < height; ++y)
@@ -265,8 +273,9 @@ void TiaOutputWidget::drawWidget(bool hilite)
     uInt32* line_ptr = myLineBuffer.data();
     for(uInt32 x = 0; x < width; ++x, ++i)
     {
-      const uInt8 shift = i >= scanoffset ? 1 : 0;
-      const uInt32 pixel = tiaSurface.mapIndexedPixel(tiaOutputBuffer[i], shift);
+      const uInt32 pixel = i >= scanoffset
+        ? tiaSurface.mapIndexedPixel(tiaLastFrame[i], 1)
+        : tiaSurface.mapIndexedPixel(tiaOutputBuffer[i], 0);
       *line_ptr++ = pixel;
       *line_ptr++ = pixel;
     }
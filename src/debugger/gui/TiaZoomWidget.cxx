@@ -300,7 +300,13 @@ string TiaZoomWidget::getToolTip(const Common::Point& pos) const
 
   const Int32 i = idx.x + idx.y * instance().console().tia().width();
   const uInt32 startLine = instance().console().tia().startLine();
-  const uInt8* tiaOutputBuffer = instance().console().tia().outputBuffer();
+  // Below the beam, the last frame is shown
+  uInt32 scanx = 0, scany = 0;
+  instance().console().tia().electronBeamPos(scanx, scany);
+  const uInt32 scanoffset = instance().console().tia().width() * scany + scanx;
+  const uInt8* tiaOutputBuffer = static_cast<uInt32>(i) > scanoffset
+    ? instance().console().tia().lastFrameBuffer()
+    : instance().console().tia().outputBuffer();
   ostringstream buf;
 
   buf << _toolTipText
@@ -331,6 +337,7 @@ void TiaZoomWidget::drawWidget(bool hilite)
   // This probably isn't as efficient as it can be, but it's a small area
   // and I don't have time to make it faster :)
   const uInt8* currentFrame  = instance().console().tia().outputBuffer();
+  const uInt8* lastFrame     = instance().console().tia().lastFrameBuffer();
   const int width = instance().console().tia().width(),
             wzoom = myZoomLevel << 1,
             hzoom = myZoomLevel;
@@ -346,7 +353,8 @@ void TiaZoomWidget::drawWidget(bool hilite)
     for(int x = myOffX >> 1, col = 0; x < (myNumCols+myOffX) >> 1; ++x, col += wzoom)
     {
       const uInt32 idx = y*width + x;
-      const auto color = static_cast<ColorId>(currentFrame[idx] | (idx > scanoffset ? 1 : 0));
+      const auto color = static_cast<ColorId>(idx > scanoffset
+          ? lastFrame[idx] | 1 : currentFrame[idx]);
       s.fillRect(_x + col + 1, _y + row + 1, wzoom, hzoom, color);
     }
   }
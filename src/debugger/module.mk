@@ -8,6 +8,7 @@ MODULE_OBJS := \
         src/debugger/CpuDebug.o \
         src/debugger/DiStella.o \
         src/debugger/RiotDebug.o \
+        src/debugger/ThumbProfiler.o \
         src/debugger/TIADebug.o \
         src/debugger/TimerMap.o
 
@@ -24,6 +24,7 @@ class CartDebugWidget;
 class CartRamWidget;
 class GuiObject;
 class Settings;
+class ThumbProfiler;
 
 #include <functional>
 
@@ -335,6 +336,11 @@ class Cartridge : public Device
     {
       return nullptr;
     }
+
+    /**
+      Get the profiler of the ARM code, for carts using the Thumbulator.
+    */
+    virtual ThumbProfiler* armProfiler() { return nullptr; }
   #endif
 
   protected:
@@ -79,6 +79,8 @@ class CartridgeARM : public Cartridge
     const Thumbulator::Stats& prevStats() const { return myPrevStats; }
     uInt32 cycles() const { return myCycles; }
     uInt32 prevCycles() const { return myPrevCycles; }
+
+    ThumbProfiler* armProfiler() override { return &myThumbEmulator->profiler(); }
   #endif
 
     void incCycles(bool enable);
@@ -15,6 +15,8 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <bitset>
+
 #include "bspf.hxx"
 #include "Logger.hxx"
 
@@ -24,12 +26,16 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t size)
 {
+  // Search for all signatures at once, the heuristics below only query
+  // the results
+  const SignatureHits hits(image, size);
+
   // Guess type based on size
   Bankswitch::Type type = Bankswitch::Type::_AUTO;
 
   if((size % 8448) == 0 || size == 6_KB)
   {
-    if(size == 6_KB && isProbablyGL(image, size))
+    if(size == 6_KB && isProbablyGL(hits))
       type = Bankswitch::Type::_GL;
     else
       type = Bankswitch::Type::_AR;
@@ -37,17 +43,17 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t si
   else if((size <= 2_KB) ||
           (size == 4_KB && std::memcmp(image.get(), image.get() + 2_KB, 2_KB) == 0))
   {
-    type = isProbablyCV(image, size) ? Bankswitch::Type::_CV : Bankswitch::Type::_2K;
+    type = isProbablyCV(hits) ? Bankswitch::Type::_CV : Bankswitch::Type::_2K;
   }
   else if(size == 4_KB)
   {
-    if(isProbablyCV(image, size))
+    if(isProbablyCV(hits))
       type = Bankswitch::Type::_CV;
     else if(isProbably4KSC(image, size))
       type = Bankswitch::Type::_4KSC;
-    else if (isProbablyFC(image, size))
+    else if (isProbablyFC(hits))
       type = Bankswitch::Type::_FC;
-    else if (isProbablyGL(image, size))
+    else if (isProbablyGL(hits))
       type = Bankswitch::Type::_GL;
     else
       type = Bankswitch::Type::_4K;
@@ -55,40 +61,35 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t si
   else if(size == 8_KB)
   {
     // First check for *potential* F8
-    static constexpr uInt8 signature[2][3] = {
-      { 0x8D, 0xF9, 0x1F },  // STA $1FF9
-      { 0x8D, 0xF9, 0xFF }   // STA $FFF9
-    };
-    const bool f8 = searchForBytes(image, size, signature[0], 3, 2) ||
-                    searchForBytes(image, size, signature[1], 3, 2);
+    const bool f8 = hits.found(Sig::STA_1FF9, 2) || hits.found(Sig::STA_FFF9, 2);
 
     if(isProbablySC(image, size))
       type = Bankswitch::Type::_F8SC;
     else if(std::memcmp(image.get(), image.get() + 4_KB, 4_KB) == 0)
       type = Bankswitch::Type::_4K;
-    else if(isProbablyE0(image, size))
+    else if(isProbablyE0(hits))
       type = Bankswitch::Type::_E0;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
-    else if(isProbablyUA(image, size))
+    else if(isProbablyUA(hits))
       type = Bankswitch::Type::_UA;
-    else if(isProbably0FA0(image, size))
+    else if(isProbably0FA0(hits))
       type = Bankswitch::Type::_0FA0;
-    else if(isProbablyFE(image, size) && !f8)
+    else if(isProbablyFE(hits) && !f8)
       type = Bankswitch::Type::_FE;
-    else if(isProbably0840(image, size))
+    else if(isProbably0840(hits))
       type = Bankswitch::Type::_0840;
-    else if(isProbablyE78K(image, size))
+    else if(isProbablyE78K(hits))
       type = Bankswitch::Type::_E7;
-    else if (isProbablyWD(image,size))
+    else if (isProbablyWD(hits))
       type = Bankswitch::Type::_WD;
-    else if (isProbablyFC(image, size))
+    else if (isProbablyFC(hits))
       type = Bankswitch::Type::_FC;
-    else if(isProbably03E0(image, size))
+    else if(isProbably03E0(hits))
       type = Bankswitch::Type::_03E0;
     else
       type = Bankswitch::Type::_F8;
@@ -103,7 +104,7 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t si
   }
   else if(size == 12_KB)
   {
-    if(isProbablyE7(image, size))
+    if(isProbablyE7(hits))
       type = Bankswitch::Type::_E7;
     else
       type = Bankswitch::Type::_FA;
@@ -112,16 +113,16 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t si
   {
     if(isProbablySC(image, size))
       type = Bankswitch::Type::_F6SC;
-    else if(isProbablyE7(image, size))
+    else if(isProbablyE7(hits))
       type = Bankswitch::Type::_E7;
-    else if (isProbablyFC(image, size))
+    else if (isProbablyFC(hits))
       type = Bankswitch::Type::_FC;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
   /* no known 16K 3F ROMS
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
   */
     else
@@ -133,121 +134,121 @@ Bankswitch::Type CartDetector::autodetectType(const ByteBuffer& image, size_t si
   }
   else if(size == 29_KB)
   {
-    if(isProbablyARM(image, size))
+    if(isProbablyARM(hits))
       type = Bankswitch::Type::_FA2;
-    else /*if(isProbablyDPCplus(image, size))*/
+    else /*if(isProbablyDPCplus(hits))*/
       type = Bankswitch::Type::_DPCP;
   }
   else if(size == 32_KB)
   {
-    if (isProbablyCTY(image, size))
+    if (isProbablyCTY(hits))
       type = Bankswitch::Type::_CTY;
-    else if(isProbablyCDF(image, size))
+    else if(isProbablyCDF(hits))
       type = Bankswitch::Type::_CDF;
-    else if(isProbablyDPCplus(image, size))
+    else if(isProbablyDPCplus(hits))
       type = Bankswitch::Type::_DPCP;
     else if(isProbablySC(image, size))
       type = Bankswitch::Type::_F4SC;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
-    else if (isProbablyBUS(image, size))
+    else if (isProbablyBUS(hits))
       type = Bankswitch::Type::_BUS;
     else if(isProbablyFA2(image, size))
       type = Bankswitch::Type::_FA2;
-    else if (isProbablyFC(image, size))
+    else if (isProbablyFC(hits))
       type = Bankswitch::Type::_FC;
     else
       type = Bankswitch::Type::_F4;
   }
   else if(size == 60_KB)
   {
-    if(isProbablyCTY(image, size))
+    if(isProbablyCTY(hits))
       type = Bankswitch::Type::_CTY;
     else
       type = Bankswitch::Type::_F4;
   }
   else if(size == 64_KB)
   {
-    if (isProbablyCDF(image, size))
+    if (isProbablyCDF(hits))
       type = Bankswitch::Type::_CDF;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
     else if(isProbably4A50(image, size))
       type = Bankswitch::Type::_4A50;
-    else if(isProbablyEF(image, size, type))
+    else if(isProbablyEF(image, size, hits, type))
       ; // type has been set directly in the function
-    else if(isProbablyX07(image, size))
+    else if(isProbablyX07(hits))
       type = Bankswitch::Type::_X07;
     else
       type = Bankswitch::Type::_F0;
   }
   else if(size == 128_KB)
   {
-    if (isProbablyCDF(image, size))
+    if (isProbablyCDF(hits))
       type = Bankswitch::Type::_CDF;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
     else if(isProbablyDF(image, size, type))
       ; // type has been set directly in the function
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
     else if(isProbably4A50(image, size))
       type = Bankswitch::Type::_4A50;
-    else /*if(isProbablySB(image, size))*/
+    else /*if(isProbablySB(hits))*/
       type = Bankswitch::Type::_SB;
   }
   else if(size == 256_KB)
   {
-    if (isProbablyCDF(image, size))
+    if (isProbablyCDF(hits))
       type = Bankswitch::Type::_CDF;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
     else if(isProbablyBF(image, size, type))
       ; // type has been set directly in the function
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
-    else /*if(isProbablySB(image, size))*/
+    else /*if(isProbablySB(hits))*/
       type = Bankswitch::Type::_SB;
   }
   else if(size == 512_KB)
   {
-    if(isProbablyTVBoy(image, size))
+    if(isProbablyTVBoy(hits))
       type = Bankswitch::Type::_TVBOY;
-    else if (isProbablyCDF(image, size))
+    else if (isProbablyCDF(hits))
       type = Bankswitch::Type::_CDF;
-    else if(isProbably3EX(image, size))
+    else if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
   }
   else  // what else can we do?
   {
-    if(isProbably3EX(image, size))
+    if(isProbably3EX(hits))
       type = Bankswitch::Type::_3EX;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = Bankswitch::Type::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = Bankswitch::Type::_3F;
   }
 
   // Variable sized ROM formats are independent of image size and come last
-  if(isProbably3EPlus(image, size))
+  if(isProbably3EPlus(hits))
     type = Bankswitch::Type::_3EP;
-  else if(isProbablyMDM(image, size))
+  else if(isProbablyMDM(hits))
     type = Bankswitch::Type::_MDM;
   else if(isProbablyMVC(image, size))
     type = Bankswitch::Type::_MVC;
@@ -290,6 +291,158 @@ bool CartDetector::searchForBytes(const uInt8* image, size_t imagesize,
   return (count == minhits);
 }
 
+namespace {
+  // All signatures searched for by 'CartDetector::SignatureHits', in the
+  // same order as 'CartDetector::Sig'; 'limit' restricts a search to the
+  // first bytes of the image (0 means the complete image)
+  struct Signature
+  {
+    std::array<uInt8, 8> bytes{};
+    uInt8 size{0};
+    size_t limit{0};
+  };
+
+  constexpr Signature ourSignatures[] = {
+    { { 0x8D, 0xF9, 0x1F }, 3 },  // STA $1FF9
+    { { 0x8D, 0xF9, 0xFF }, 3 },  // STA $FFF9
+    // ARM code contains the following 'loader' patterns in the first 1K
+    { { 0xA0, 0xC1, 0x1F, 0xE0 }, 4, 1_KB },
+    { { 0x00, 0x80, 0x02, 0xE0 }, 4, 1_KB },
+    { { 0x0D, 0xE0, 0x03, 0x0D }, 4 },  // ORA $3E0, ORA (Popeye)
+    { { 0xAD, 0xE0, 0x03, 0xAD }, 4 },  // LDA $3E0, ORA (Montezuma's Revenge)
+    { { 0xAD, 0x00, 0x08 }, 3 },        // LDA $0800
+    { { 0xAD, 0x40, 0x08 }, 3 },        // LDA $0840
+    { { 0x2C, 0x00, 0x08 }, 3 },        // BIT $0800
+    { { 0x0C, 0x00, 0x08, 0x4C }, 4 },  // NOP $0800; JMP ...
+    { { 0x0C, 0xFF, 0x0F, 0x4C }, 4 },  // NOP $0FFF; JMP ...
+    { { 0x2C, 0xC0, 0x0F }, 3 },  // BIT $FC0  (H.E.R.O., Kung-Fu Master)
+    { { 0x8D, 0xC0, 0x0F }, 3 },  // STA $FC0  (Pole Position, Subterranea)
+    { { 0xAD, 0xC0, 0x0F }, 3 },  // LDA $FC0  (Front Line, Zaxxon)
+    { { 0x2C, 0xC0, 0xEF }, 3 },  // BIT $EFC0 (Motocross)
+    { { 0x85, 0x3E }, 2 },  // STA $3E
+    { { 0x85, 0x3F }, 2 },  // STA $3F
+    { { '3', 'E', 'X' }, 3 },
+    { { 'T', 'J', '3', 'E' }, 4 },
+    { { 'B', 'U', 'S' }, 3 },
+    { { 'C', 'D', 'F' }, 3 },
+    { { 'P', 'L', 'U', 'S', 'C', 'D', 'F', 'J' }, 8 },
+    { { 'L', 'E', 'N', 'I', 'N' }, 5 },
+    { { 'D', 'P', 'C', '+' }, 4 },
+    { { 'M', 'D', 'M', 'C' }, 4, 8_KB },
+    { { 0x9D, 0xFF, 0xF3 }, 3 },  // STA $F3FF,X  MagiCard
+    { { 0x99, 0x00, 0xF4 }, 3 },  // STA $F400,Y  Video Life
+    { { 0x8D, 0xE0, 0x1F }, 3 },  // STA $1FE0
+    { { 0x8D, 0xE0, 0x5F }, 3 },  // STA $5FE0
+    { { 0x8D, 0xE9, 0xFF }, 3 },  // STA $FFE9
+    { { 0x0C, 0xE0, 0x1F }, 3 },  // NOP $1FE0
+    { { 0xAD, 0xE0, 0x1F }, 3 },  // LDA $1FE0
+    { { 0xAD, 0xE9, 0xFF }, 3 },  // LDA $FFE9
+    { { 0xAD, 0xED, 0xFF }, 3 },  // LDA $FFED
+    { { 0xAD, 0xF3, 0xBF }, 3 },  // LDA $BFF3
+    { { 0xAD, 0xE2, 0xFF }, 3 },  // LDA $FFE2
+    { { 0xAD, 0xE4, 0xFF }, 3 },  // LDA $FFE4
+    { { 0xAD, 0xE5, 0xFF }, 3 },  // LDA $FFE5
+    { { 0xAD, 0xE6, 0xFF }, 3 },  // LDA $FFE6
+    { { 0xAD, 0xE5, 0x1F }, 3 },  // LDA $1FE5
+    { { 0xAD, 0xE7, 0x1F }, 3 },  // LDA $1FE7
+    { { 0x0C, 0xE7, 0x1F }, 3 },  // NOP $1FE7
+    { { 0x8D, 0xE7, 0xFF }, 3 },  // STA $FFE7
+    { { 0x8D, 0xE7, 0x1F }, 3 },  // STA $1FE7
+    { { 0x0C, 0xE0, 0xFF }, 3 },  // NOP $FFE0
+    { { 0xAD, 0xE0, 0xFF }, 3 },  // LDA $FFE0
+    { { 0x8d, 0xf8, 0x1f, 0x4a, 0x4a, 0x8d }, 6 }, // STA $1FF8, LSR, LSR, STA... Power Play Arcade Menus, 3-D Ghost Attack
+    { { 0x8d, 0xf8, 0xff, 0x8d, 0xfc, 0xff }, 6 }, // STA $FFF8, STA $FFFC        Surf's Up (4K)
+    { { 0x8c, 0xf9, 0xff, 0xad, 0xfc, 0xff }, 6 }, // STY $FFF9, LDA $FFFC        3-D Havoc
+    { { 0x20, 0x00, 0xD0, 0xC6, 0xC5 }, 5 },  // JSR $D000; DEC $C5  Decathlon
+    { { 0x20, 0xC3, 0xF8, 0xA5, 0x82 }, 5 },  // JSR $F8C3; LDA $82  Robot Tank
+    { { 0xD0, 0xFB, 0x20, 0x73, 0xFE }, 5 },  // BNE $FB; JSR $FE73  Space Shuttle (NTSC/PAL)
+    { { 0xD0, 0xFB, 0x20, 0x68, 0xFE }, 5 },  // BNE $FB; JSR $FE73  Space Shuttle (SECAM)
+    { { 0x20, 0x00, 0xF0, 0x84, 0xD6 }, 5 },  // JSR $F000; $84, $D6 Thwocker
+    { { 0xad, 0xb8, 0x0c }, 3 },  // LDA $0CB8
+    { { 0xBD, 0x00, 0x08 }, 3 },  // LDA $0800,x
+    { { 0x91, 0x82, 0x6c, 0xfc, 0xff }, 5 },  // STA ($82),Y; JMP ($FFFC)
+    { { 0x8D, 0x40, 0x02 }, 3 },  // STA $240 (Funky Fish, Pleiades)
+    { { 0xAD, 0x40, 0x02 }, 3 },  // LDA $240 (???)
+    { { 0xBD, 0x1F, 0x02 }, 3 },  // LDA $21F,X (Gingerbread Man)
+    { { 0x2C, 0xC0, 0x02 }, 3 },  // BIT $2C0 (Time Pilot)
+    { { 0x8D, 0xC0, 0x02 }, 3 },  // STA $2C0 (Fathom, Vanguard)
+    { { 0xAD, 0xC0, 0x02 }, 3 },  // LDA $2C0 (Mickey)
+    { { 0xA5, 0x39, 0x4C }, 3 },  // LDA $39, JMP
+    { { 0xAD, 0x0D, 0x08 }, 3 },  // LDA $080D
+    { { 0xAD, 0x1D, 0x08 }, 3 },  // LDA $081D
+    { { 0xAD, 0x2D, 0x08 }, 3 },  // LDA $082D
+    { { 0x0C, 0x0D, 0x08 }, 3 },  // NOP $080D
+    { { 0x0C, 0x1D, 0x08 }, 3 },  // NOP $081D
+    { { 0x0C, 0x2D, 0x08 }, 3 }   // NOP $082D
+  };
+  constexpr size_t NUM_SIGNATURES = sizeof(ourSignatures) / sizeof(Signature);
+
+  /**
+    Prefilter over all signatures, so that the image can be searched for all
+    of them in a single pass. Every position is first checked against the
+    set of the first two bytes of all signatures; only the (rare) positions
+    passing this test are compared with the complete signatures.
+  */
+  class SignatureFilter
+  {
+    public:
+      SignatureFilter()
+      {
+        for(size_t s = 0; s < NUM_SIGNATURES; ++s)
+        {
+          const Signature& sig = ourSignatures[s];
+          myPrefixes.set(sig.bytes[0] | (sig.bytes[1] << 8));
+          myCandidates[sig.bytes[0]].push_back(static_cast<uInt8>(s));
+        }
+      }
+
+      /**
+        Count the non-overlapping hits of all signatures, exactly like
+        'CartDetector::searchForBytes' would (capped at 255)
+      */
+      void scan(const uInt8* image, size_t size, uInt8* hits) const
+      {
+        std::array<size_t, NUM_SIGNATURES> nextPos{};
+
+        for(size_t pos = 0; pos + 1 < size; ++pos)
+        {
+          if(!myPrefixes.test(image[pos] | (image[pos + 1] << 8)))
+            continue;
+
+          for(const uInt8 s: myCandidates[image[pos]])
+          {
+            const Signature& sig = ourSignatures[s];
+            const size_t end = sig.limit ? std::min(size, sig.limit) : size;
+
+            // 'searchForBytes' never matches at the very last position, and
+            // skips one byte past each hit
+            if(pos + sig.size < end && pos >= nextPos[s] &&
+               std::memcmp(image + pos, sig.bytes.data(), sig.size) == 0)
+            {
+              if(hits[s] < 255)
+                ++hits[s];
+              nextPos[s] = pos + sig.size + 1;
+            }
+          }
+        }
+      }
+
+    private:
+      std::bitset<65536> myPrefixes;
+      std::array<vector<uInt8>, 256> myCandidates;
+  };
+} // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CartDetector::SignatureHits::SignatureHits(const ByteBuffer& image, size_t size)
+{
+  static_assert(NUM_SIGNATURES == static_cast<size_t>(Sig::NumSigs),
+                "Signature table does not match CartDetector::Sig");
+  static const SignatureFilter filter;
+
+  filter.scan(image.get(), size, myHits.data());
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartDetector::isProbablySC(const ByteBuffer& image, size_t size)
 {
@@ -308,120 +461,76 @@ bool CartDetector::isProbablySC(const ByteBuffer& image, size_t size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyARM(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyARM(const SignatureHits& hits)
 {
   // ARM code contains the following 'loader' patterns in the first 1K
   // Thanks to Thomas Jentzsch of AtariAge for this advice
-  static constexpr uInt8 signature[2][4] = {
-    { 0xA0, 0xC1, 0x1F, 0xE0 },
-    { 0x00, 0x80, 0x02, 0xE0 }
-  };
-  if(searchForBytes(image, std::min<size_t>(size, 1_KB), signature[0], 4))
-    return true;
-  else
-    return searchForBytes(image, std::min<size_t>(size, 1_KB), signature[1], 4);
+  return hits.foundAny({ Sig::ARM_LOADER_0, Sig::ARM_LOADER_1 });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably03E0(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably03E0(const SignatureHits& hits)
 {
   // 03E0 cart bankswitching for Brazilian Parker Bros ROMs, switches segment
   // 0 into bank 0 by accessing address 0x3E0 using 'LDA $3E0' or 'ORA $3E0'.
-  static constexpr uInt8 signature[2][4] = {
-    { 0x0D, 0xE0, 0x03, 0x0D },  // ORA $3E0, ORA (Popeye)
-    { 0xAD, 0xE0, 0x03, 0xAD }   // LDA $3E0, ORA (Montezuma's Revenge)
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 4))
-      return true;
-
-  return false;
+  return hits.foundAny({ Sig::ORA_3E0_ORA, Sig::LDA_3E0_ORA });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably0840(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably0840(const SignatureHits& hits)
 {
   // 0840 cart bankswitching is triggered by accessing addresses 0x0800
   // or 0x0840 at least twice
-  static constexpr uInt8 signature1[3][3] = {
-    { 0xAD, 0x00, 0x08 },  // LDA $0800
-    { 0xAD, 0x40, 0x08 },  // LDA $0840
-    { 0x2C, 0x00, 0x08 }   // BIT $0800
-  };
-  for(const auto* const sig: signature1)
-    if(searchForBytes(image, size, sig, 3, 2))
-      return true;
-
-  static constexpr uInt8 signature2[2][4] = {
-    { 0x0C, 0x00, 0x08, 0x4C },  // NOP $0800; JMP ...
-    { 0x0C, 0xFF, 0x0F, 0x4C }   // NOP $0FFF; JMP ...
-  };
-  for(const auto* const sig: signature2)
-    if(searchForBytes(image, size, sig, 4, 2))
+  for(const auto sig: { Sig::LDA_0800, Sig::LDA_0840, Sig::BIT_0800,
+                        Sig::NOP_0800_JMP, Sig::NOP_0FFF_JMP })
+    if(hits.found(sig, 2))
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably0FA0(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably0FA0(const SignatureHits& hits)
 {
   // Other Brazilian (Fotomania) ROM's bankswitching switches to bank 1 by
   // accessing address 0xFC0 using 'BIT $FC0', 'BIT $FC0' or 'STA $FC0'
   // Also a game (Motocross) using 'BIT $EFC0' has been found
-  static constexpr uInt8 signature[4][3] = {
-    { 0x2C, 0xC0, 0x0F },  // BIT $FC0  (H.E.R.O., Kung-Fu Master)
-    { 0x8D, 0xC0, 0x0F },  // STA $FC0  (Pole Position, Subterranea)
-    { 0xAD, 0xC0, 0x0F },  // LDA $FC0  (Front Line, Zaxxon)
-    { 0x2C, 0xC0, 0xEF }   // BIT $EFC0 (Motocross)
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 3))
-      return true;
-
-  return false;
+  return hits.foundAny({ Sig::BIT_FC0, Sig::STA_FC0, Sig::LDA_FC0, Sig::BIT_EFC0 });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3E(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably3E(const SignatureHits& hits)
 {
   // 3E cart RAM bankswitching is triggered by storing the bank number
   // in address 3E using 'STA $3E', ROM bankswitching is triggered by
   // storing the bank number in address 3F using 'STA $3F'.
   // We expect the latter will be present at least 2 times, since there
   // are at least two banks
-
-  static constexpr uInt8 signature1[] = { 0x85, 0x3E };  // STA $3E
-  static constexpr uInt8 signature2[] = { 0x85, 0x3F };  // STA $3F
-  return searchForBytes(image, size, signature1, 2)
-    && searchForBytes(image, size, signature2, 2, 2);
+  return hits.found(Sig::STA_3E) && hits.found(Sig::STA_3F, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3EX(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably3EX(const SignatureHits& hits)
 {
   // 3EX cart have at least 2 occurrences of the string "3EX"
-  static constexpr uInt8 _3EX[] = { '3', 'E', 'X' };
-  return searchForBytes(image, size, _3EX, 3, 2);
+  return hits.found(Sig::STR_3EX, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3EPlus(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably3EPlus(const SignatureHits& hits)
 {
   // 3E+ cart is identified key 'TJ3E' in the ROM
-  static constexpr uInt8 tj3e[] = { 'T', 'J', '3', 'E' };
-  return searchForBytes(image, size, tj3e, 4);
+  return hits.found(Sig::STR_TJ3E);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3F(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbably3F(const SignatureHits& hits)
 {
   // 3F cart bankswitching is triggered by storing the bank number
   // in address 3F using 'STA $3F'
   // We expect it will be present at least 2 times, since there are
   // at least two banks
-  static constexpr uInt8 signature[] = { 0x85, 0x3F };  // STA $3F
-  return searchForBytes(image, size, signature, 2, 2);
+  return hits.found(Sig::STA_3F, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -478,47 +587,35 @@ bool CartDetector::isProbablyBF(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyBUS(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyBUS(const SignatureHits& hits)
 {
   // BUS ARM code has 2 occurrences of the string BUS
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  static constexpr uInt8 bus[] = { 'B', 'U', 'S' };
-  return searchForBytes(image, size, bus, 3, 2);
+  return hits.found(Sig::STR_BUS, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCDF(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyCDF(const SignatureHits& hits)
 {
   // CDF ARM code has 3 occurrences of the string CDF
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  static constexpr uInt8 cdf[] = { 'C', 'D', 'F' };
-  static constexpr uInt8 cdfjplus[] = { 'P', 'L', 'U', 'S', 'C', 'D', 'F', 'J' };
-  return (searchForBytes(image, size, cdf, 3, 3) ||
-          searchForBytes(image, size, cdfjplus, 8, 1));
+  return hits.found(Sig::STR_CDF, 3) || hits.found(Sig::STR_PLUSCDFJ);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCTY(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyCTY(const SignatureHits& hits)
 {
-  static constexpr uInt8 lenin[] = { 'L', 'E', 'N', 'I', 'N' };
-  return searchForBytes(image, size, lenin, 5);
+  return hits.found(Sig::STR_LENIN);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCV(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyCV(const SignatureHits& hits)
 {
   // CV RAM access occurs at addresses $f3ff and $f400
   // These signatures are attributed to the MESS project
-  static constexpr uInt8 signature[2][3] = {
-    { 0x9D, 0xFF, 0xF3 },  // STA $F3FF,X  MagiCard
-    { 0x99, 0x00, 0xF4 }   // STA $F400,Y  Video Life
-  };
-  if(searchForBytes(image, size, signature[0], 3))
-    return true;
-  else
-    return searchForBytes(image, size, signature[1], 3);
+  return hits.foundAny({ Sig::STA_F3FF_X, Sig::STA_F400_Y });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -545,17 +642,16 @@ bool CartDetector::isProbablyDF(const ByteBuffer& image, size_t size,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDPCplus(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyDPCplus(const SignatureHits& hits)
 {
   // DPC+ ARM code has 2 occurrences of the string DPC+
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  static constexpr uInt8 dpcp[] = { 'D', 'P', 'C', '+' };
-  return searchForBytes(image, size, dpcp, 4, 2);
+  return hits.found(Sig::STR_DPCP, 2);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE0(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyE0(const SignatureHits& hits)
 {
   // E0 cart bankswitching is triggered by accessing addresses
   // $FE0 to $FF9 using absolute non-indexed addressing
@@ -563,25 +659,12 @@ bool CartDetector::isProbablyE0(const ByteBuffer& image, size_t size)
   // search for only certain known signatures
   // Thanks to "stella@casperkitty.com" for this advice
   // These signatures are attributed to the MESS project
-  static constexpr uInt8 signature[8][3] = {
-    { 0x8D, 0xE0, 0x1F },  // STA $1FE0
-    { 0x8D, 0xE0, 0x5F },  // STA $5FE0
-    { 0x8D, 0xE9, 0xFF },  // STA $FFE9
-    { 0x0C, 0xE0, 0x1F },  // NOP $1FE0
-    { 0xAD, 0xE0, 0x1F },  // LDA $1FE0
-    { 0xAD, 0xE9, 0xFF },  // LDA $FFE9
-    { 0xAD, 0xED, 0xFF },  // LDA $FFED
-    { 0xAD, 0xF3, 0xBF }   // LDA $BFF3
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 3))
-      return true;
-
-  return false;
+  return hits.foundAny({ Sig::STA_1FE0, Sig::STA_5FE0, Sig::STA_FFE9, Sig::NOP_1FE0,
+                         Sig::LDA_1FE0, Sig::LDA_FFE9, Sig::LDA_FFED, Sig::LDA_BFF3 });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE7(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyE7(const SignatureHits& hits)
 {
   // E7 cart bankswitching is triggered by accessing addresses
   // $FE0 to $FE6 using absolute non-indexed addressing
@@ -589,44 +672,23 @@ bool CartDetector::isProbablyE7(const ByteBuffer& image, size_t size)
   // search for only certain known signatures
   // Thanks to "stella@casperkitty.com" for this advice
   // These signatures are attributed to the MESS project
-  static constexpr uInt8 signature[7][3] = {
-    { 0xAD, 0xE2, 0xFF },  // LDA $FFE2
-    { 0xAD, 0xE5, 0xFF },  // LDA $FFE5
-    { 0xAD, 0xE5, 0x1F },  // LDA $1FE5
-    { 0xAD, 0xE7, 0x1F },  // LDA $1FE7
-    { 0x0C, 0xE7, 0x1F },  // NOP $1FE7
-    { 0x8D, 0xE7, 0xFF },  // STA $FFE7
-    { 0x8D, 0xE7, 0x1F }   // STA $1FE7
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 3))
-      return true;
-
-  return false;
+  return hits.foundAny({ Sig::LDA_FFE2, Sig::LDA_FFE5, Sig::LDA_1FE5, Sig::LDA_1FE7,
+                         Sig::NOP_1FE7, Sig::STA_FFE7, Sig::STA_1FE7 });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE78K(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyE78K(const SignatureHits& hits)
 {
   // E78K cart bankswitching is triggered by accessing addresses
   // $FE4 to $FE6 using absolute non-indexed addressing
   // To eliminate false positives (and speed up processing), we
   // search for only certain known signatures
-  static constexpr uInt8 signature[3][3] = {
-    { 0xAD, 0xE4, 0xFF },  // LDA $FFE4
-    { 0xAD, 0xE5, 0xFF },  // LDA $FFE5
-    { 0xAD, 0xE6, 0xFF },  // LDA $FFE6
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 3))
-      return true;
-
-  return false;
+  return hits.foundAny({ Sig::LDA_FFE4, Sig::LDA_FFE5, Sig::LDA_FFE6 });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartDetector::isProbablyEF(const ByteBuffer& image, size_t size,
-                                Bankswitch::Type& type)
+                                const SignatureHits& hits, Bankswitch::Type& type)
 {
   // Newer EF carts store strings 'EFEF' and 'EFSC' starting at address $FFF8
   // This signature is attributed to "RevEng" of AtariAge
@@ -646,21 +708,8 @@ bool CartDetector::isProbablyEF(const ByteBuffer& image, size_t size,
   // Otherwise, EF cart bankswitching switches banks by accessing addresses
   // 0xFE0 to 0xFEF, usually with either a NOP or LDA
   // It's likely that the code will switch to bank 0, so that's what is tested
-  bool isEF = false;
-  static constexpr uInt8 signature[4][3] = {
-    { 0x0C, 0xE0, 0xFF },  // NOP $FFE0
-    { 0xAD, 0xE0, 0xFF },  // LDA $FFE0
-    { 0x0C, 0xE0, 0x1F },  // NOP $1FE0
-    { 0xAD, 0xE0, 0x1F }   // LDA $1FE0
-  };
-  for(const auto* const sig: signature)
-  {
-    if(searchForBytes(image, size, sig, 3))
-    {
-      isEF = true;
-      break;
-    }
-  }
+  const bool isEF = hits.foundAny({ Sig::NOP_FFE0, Sig::LDA_FFE0,
+                                    Sig::NOP_1FE0, Sig::LDA_1FE0 });
 
   // Now that we know that the ROM is EF, we need to check if it's
   // the SC variant
@@ -689,55 +738,32 @@ bool CartDetector::isProbablyFA2(const ByteBuffer& image, size_t)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyFC(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyFC(const SignatureHits& hits)
 {
   // FC bankswitching uses consecutive writes to 3 hotspots
-  static constexpr uInt8 signature[3][6] = {
-    { 0x8d, 0xf8, 0x1f, 0x4a, 0x4a, 0x8d }, // STA $1FF8, LSR, LSR, STA... Power Play Arcade Menus, 3-D Ghost Attack
-    { 0x8d, 0xf8, 0xff, 0x8d, 0xfc, 0xff }, // STA $FFF8, STA $FFFC        Surf's Up (4K)
-    { 0x8c, 0xf9, 0xff, 0xad, 0xfc, 0xff }  // STY $FFF9, LDA $FFFC        3-D Havoc
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 6))
-      return true;
-
-  return false;
+  return hits.foundAny({ Sig::FC_0, Sig::FC_1, Sig::FC_2 });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyFE(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyFE(const SignatureHits& hits)
 {
   // FE bankswitching is very weird, but always seems to include a
   // 'JSR $xxxx'
   // These signatures are (mostly) attributed to the MESS project
-  static constexpr uInt8 signature[5][5] = {
-    { 0x20, 0x00, 0xD0, 0xC6, 0xC5 },  // JSR $D000; DEC $C5  Decathlon
-    { 0x20, 0xC3, 0xF8, 0xA5, 0x82 },  // JSR $F8C3; LDA $82  Robot Tank
-    { 0xD0, 0xFB, 0x20, 0x73, 0xFE },  // BNE $FB; JSR $FE73  Space Shuttle (NTSC/PAL)
-    { 0xD0, 0xFB, 0x20, 0x68, 0xFE },  // BNE $FB; JSR $FE73  Space Shuttle (SECAM)
-    { 0x20, 0x00, 0xF0, 0x84, 0xD6 }   // JSR $F000; $84, $D6 Thwocker
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 5))
-      return true;
-
-  return false;
+  return hits.foundAny({ Sig::FE_0, Sig::FE_1, Sig::FE_2, Sig::FE_3, Sig::FE_4 });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyGL(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyGL(const SignatureHits& hits)
 {
-  static constexpr uInt8 signature[] = { 0xad, 0xb8, 0x0c };  // LDA $0CB8
-
-  return searchForBytes(image, size, signature, 3);
+  return hits.found(Sig::LDA_0CB8);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyMDM(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyMDM(const SignatureHits& hits)
 {
   // MDM cart is identified key 'MDMC' in the first 8K of ROM
-  static constexpr uInt8 mdmc[] = { 'M', 'D', 'M', 'C' };
-  return searchForBytes(image, std::min<size_t>(size, 8_KB), mdmc, 4);
+  return hits.found(Sig::STR_MDMC);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -773,76 +799,43 @@ size_t CartDetector::isProbablyMVC(const FSNode& rom)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablySB(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablySB(const SignatureHits& hits)
 {
   // SB cart bankswitching switches banks by accessing address 0x0800
-  static constexpr uInt8 signature[2][3] = {
-    { 0xBD, 0x00, 0x08 },  // LDA $0800,x
-    { 0xAD, 0x00, 0x08 }   // LDA $0800
-  };
-  if(searchForBytes(image, size, signature[0], 3))
-    return true;
-  else
-    return searchForBytes(image, size, signature[1], 3);
+  return hits.foundAny({ Sig::LDA_0800_X, Sig::LDA_0800 });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyTVBoy(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyTVBoy(const SignatureHits& hits)
 {
   // TV Boy cart bankswitching switches banks by accessing addresses 0x1800..$187F
-  static constexpr uInt8 signature[5] = { 0x91, 0x82, 0x6c, 0xfc, 0xff };  // STA ($82),Y; JMP ($FFFC)
-  return searchForBytes(image, size, signature, 5);
+  return hits.found(Sig::TVBOY);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyUA(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyUA(const SignatureHits& hits)
 {
   // UA cart bankswitching switches to bank 1 by accessing address 0x240
   // using 'STA $240' or 'LDA $240'.
   // Brazilian (Digivison) cart bankswitching switches to bank 1 by accessing address 0x2C0
   // using 'BIT $2C0', 'STA $2C0' or 'LDA $2C0'
-  static constexpr uInt8 signature[6][3] = {
-    { 0x8D, 0x40, 0x02 },  // STA $240 (Funky Fish, Pleiades)
-    { 0xAD, 0x40, 0x02 },  // LDA $240 (???)
-    { 0xBD, 0x1F, 0x02 },  // LDA $21F,X (Gingerbread Man)
-    { 0x2C, 0xC0, 0x02 },  // BIT $2C0 (Time Pilot)
-    { 0x8D, 0xC0, 0x02 },  // STA $2C0 (Fathom, Vanguard)
-    { 0xAD, 0xC0, 0x02 },  // LDA $2C0 (Mickey)
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 3))
-      return true;
-
-  return false;
+  return hits.foundAny({ Sig::STA_240, Sig::LDA_240, Sig::LDA_21F_X,
+                         Sig::BIT_2C0, Sig::STA_2C0, Sig::LDA_2C0 });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyWD(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyWD(const SignatureHits& hits)
 {
   // WD cart bankswitching switches banks by accessing address 0x30..0x3f
-  static constexpr uInt8 signature[1][3] = {
-    { 0xA5, 0x39, 0x4C }  // LDA $39, JMP
-  };
-  return searchForBytes(image, size, signature[0], 3);
+  return hits.found(Sig::LDA_39_JMP);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyX07(const ByteBuffer& image, size_t size)
+bool CartDetector::isProbablyX07(const SignatureHits& hits)
 {
   // X07 bankswitching switches to bank 0, 1, 2, etc by accessing address 0x08xd
-  static constexpr uInt8 signature[6][3] = {
-    { 0xAD, 0x0D, 0x08 },  // LDA $080D
-    { 0xAD, 0x1D, 0x08 },  // LDA $081D
-    { 0xAD, 0x2D, 0x08 },  // LDA $082D
-    { 0x0C, 0x0D, 0x08 },  // NOP $080D
-    { 0x0C, 0x1D, 0x08 },  // NOP $081D
-    { 0x0C, 0x2D, 0x08 }   // NOP $082D
-  };
-  for(const auto* const sig: signature)
-    if(searchForBytes(image, size, sig, 3))
-      return true;
-
-  return false;
+  return hits.foundAny({ Sig::LDA_080D, Sig::LDA_081D, Sig::LDA_082D,
+                         Sig::NOP_080D, Sig::NOP_081D, Sig::NOP_082D });
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
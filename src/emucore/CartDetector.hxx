@@ -53,6 +53,72 @@ class CartDetector
     static bool isProbablyPlusROM(const ByteBuffer& image, size_t size);
 
   private:
+    /**
+      All byte signatures which are searched for in the complete image by
+      the detection heuristics below (see 'ourSignatures' for their bytes)
+    */
+    enum class Sig: uInt8 {
+      STA_1FF9, STA_FFF9,                               // F8
+      ARM_LOADER_0, ARM_LOADER_1,                       // ARM (first 1K only)
+      ORA_3E0_ORA, LDA_3E0_ORA,                         // 03E0
+      LDA_0800, LDA_0840, BIT_0800,                     // 0840, SB
+      NOP_0800_JMP, NOP_0FFF_JMP,                       // 0840
+      BIT_FC0, STA_FC0, LDA_FC0, BIT_EFC0,              // 0FA0
+      STA_3E, STA_3F,                                   // 3E, 3F
+      STR_3EX, STR_TJ3E, STR_BUS, STR_CDF, STR_PLUSCDFJ,
+      STR_LENIN, STR_DPCP,
+      STR_MDMC,                                         // MDM (first 8K only)
+      STA_F3FF_X, STA_F400_Y,                           // CV
+      STA_1FE0, STA_5FE0, STA_FFE9, NOP_1FE0, LDA_1FE0, // E0, EF
+      LDA_FFE9, LDA_FFED, LDA_BFF3,
+      LDA_FFE2, LDA_FFE4, LDA_FFE5, LDA_FFE6,           // E7, E78K
+      LDA_1FE5, LDA_1FE7, NOP_1FE7, STA_FFE7, STA_1FE7,
+      NOP_FFE0, LDA_FFE0,                               // EF
+      FC_0, FC_1, FC_2,                                 // FC
+      FE_0, FE_1, FE_2, FE_3, FE_4,                     // FE
+      LDA_0CB8,                                         // GL
+      LDA_0800_X,                                       // SB
+      TVBOY,                                            // TV Boy
+      STA_240, LDA_240, LDA_21F_X,                      // UA
+      BIT_2C0, STA_2C0, LDA_2C0,
+      LDA_39_JMP,                                       // WD
+      LDA_080D, LDA_081D, LDA_082D,                     // X07
+      NOP_080D, NOP_081D, NOP_082D,
+      NumSigs
+    };
+
+    /**
+      The number of hits of each signature, as found by a single pass over
+      the ROM image. Hits are counted exactly like 'searchForBytes' does
+      (i.e. non-overlapping), so the heuristics can query any signature
+      and minimum number of hits without rescanning the image.
+    */
+    class SignatureHits
+    {
+      public:
+        SignatureHits(const ByteBuffer& image, size_t size);
+
+        /**
+          Returns true if the signature was found at least 'minhits' times
+        */
+        bool found(Sig sig, uInt32 minhits = 1) const {
+          return myHits[static_cast<size_t>(sig)] >= minhits;
+        }
+
+        /**
+          Returns true if any of the signatures was found at least once
+        */
+        bool foundAny(std::initializer_list<Sig> sigs) const {
+          for(const auto sig: sigs)
+            if(found(sig))
+              return true;
+          return false;
+        }
+
+      private:
+        std::array<uInt8, static_cast<size_t>(Sig::NumSigs)> myHits{};
+    };
+
     /**
       Search the image for the specified byte signature
 
@@ -84,42 +150,42 @@ class CartDetector
     /**
       Returns true if the image probably contains ARM code in the first 1K
     */
-    static bool isProbablyARM(const ByteBuffer& image, size_t size);
+    static bool isProbablyARM(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 03E0 bankswitching cartridge
     */
-    static bool isProbably03E0(const ByteBuffer& image, size_t size);
+    static bool isProbably03E0(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 0840 bankswitching cartridge
     */
-    static bool isProbably0840(const ByteBuffer& image, size_t size);
+    static bool isProbably0840(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a Brazilian 0FA0 bankswitching cartridge
     */
-    static bool isProbably0FA0(const ByteBuffer& image, size_t size);
+    static bool isProbably0FA0(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 3E bankswitching cartridge
     */
-    static bool isProbably3E(const ByteBuffer& image, size_t size);
+    static bool isProbably3E(const SignatureHits& hits);
 
     /**
     Returns true if the image is probably a 3EX bankswitching cartridge
     */
-    static bool isProbably3EX(const ByteBuffer& image, size_t size);
+    static bool isProbably3EX(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 3E+ bankswitching cartridge
     */
-    static bool isProbably3EPlus(const ByteBuffer& image, size_t size);
+    static bool isProbably3EPlus(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 3F bankswitching cartridge
     */
-    static bool isProbably3F(const ByteBuffer& image, size_t size);
+    static bool isProbably3F(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 4A50 bankswitching cartridge
@@ -139,22 +205,22 @@ class CartDetector
     /**
       Returns true if the image is probably a BUS bankswitching cartridge
     */
-    static bool isProbablyBUS(const ByteBuffer& image, size_t size);
+    static bool isProbablyBUS(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a CDF bankswitching cartridge
     */
-    static bool isProbablyCDF(const ByteBuffer& image, size_t size);
+    static bool isProbablyCDF(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a CTY bankswitching cartridge
     */
-    static bool isProbablyCTY(const ByteBuffer& image, size_t size);
+    static bool isProbablyCTY(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a CV bankswitching cartridge
     */
-    static bool isProbablyCV(const ByteBuffer& image, size_t size);
+    static bool isProbablyCV(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a DF/DFSC bankswitching cartridge
@@ -164,27 +230,28 @@ class CartDetector
     /**
       Returns true if the image is probably a DPC+ bankswitching cartridge
     */
-    static bool isProbablyDPCplus(const ByteBuffer& image, size_t size);
+    static bool isProbablyDPCplus(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a E0 bankswitching cartridge
     */
-    static bool isProbablyE0(const ByteBuffer& image, size_t size);
+    static bool isProbablyE0(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a E7 bankswitching cartridge
     */
-    static bool isProbablyE7(const ByteBuffer& image, size_t size);
+    static bool isProbablyE7(const SignatureHits& hits);
 
     /**
     Returns true if the image is probably a E78K bankswitching cartridge
     */
-    static bool isProbablyE78K(const ByteBuffer& image, size_t size);
+    static bool isProbablyE78K(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably an EF/EFSC bankswitching cartridge
     */
-    static bool isProbablyEF(const ByteBuffer& image, size_t size, Bankswitch::Type& type);
+    static bool isProbablyEF(const ByteBuffer& image, size_t size,
+                             const SignatureHits& hits, Bankswitch::Type& type);
 
     /**
       Returns true if the image is probably an F6 bankswitching cartridge
@@ -199,22 +266,22 @@ class CartDetector
     /**
       Returns true if the image is probably an FC bankswitching cartridge
     */
-    static bool isProbablyFC(const ByteBuffer& image, size_t size);
+    static bool isProbablyFC(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably an FE bankswitching cartridge
     */
-    static bool isProbablyFE(const ByteBuffer& image, size_t size);
+    static bool isProbablyFE(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a GameLine cartridge
     */
-    static bool isProbablyGL(const ByteBuffer& image, size_t size);
+    static bool isProbablyGL(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a MDM bankswitching cartridge
     */
-    static bool isProbablyMDM(const ByteBuffer& image, size_t size);
+    static bool isProbablyMDM(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably an MVC movie cartridge
@@ -224,27 +291,27 @@ class CartDetector
     /**
       Returns true if the image is probably a SB bankswitching cartridge
     */
-    static bool isProbablySB(const ByteBuffer& image, size_t size);
+    static bool isProbablySB(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a TV Boy bankswitching cartridge
     */
-    static bool isProbablyTVBoy(const ByteBuffer& image, size_t size);
+    static bool isProbablyTVBoy(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a UA bankswitching cartridge
     */
-    static bool isProbablyUA(const ByteBuffer& image, size_t size);
+    static bool isProbablyUA(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a Wickstead Design bankswitching cartridge
     */
-    static bool isProbablyWD(const ByteBuffer& image, size_t size);
+    static bool isProbablyWD(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably an X07 bankswitching cartridge
     */
-    static bool isProbablyX07(const ByteBuffer& image, size_t size);
+    static bool isProbablyX07(const SignatureHits& hits);
 
   private:
     // Following constructors and assignment operators not supported
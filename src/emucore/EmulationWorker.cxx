@@ -25,7 +25,8 @@
 using namespace std::chrono;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-EmulationWorker::EmulationWorker()
+EmulationWorker::EmulationWorker(bool continuous)
+  : myContinuous{continuous}
 {
   std::mutex mutex;
   std::unique_lock<std::mutex> lock(mutex);
@@ -159,12 +160,16 @@ void EmulationWorker::threadMain(std::condition_variable* initializedCondition,
     }
 
     // Loop until we have an exit condition
-    while (myPendingSignal != Signal::quit) handleWakeup(lock);
+    if (myContinuous)
+      continuousMain(lock);
+    else
+      while (myPendingSignal != Signal::quit) handleWakeup(lock);
   }
   catch (...) {
     // Store away the exception and the state accordingly
     myPendingException = std::current_exception();
     myState = State::exception;
+    myInEmulation = false;
 
     // Raising the exit condition is consistent and makes shure that the main thread
     // will not deadlock if an exception is raised while it is waiting for a signal
@@ -299,6 +304,148 @@ void EmulationWorker::dispatchEmulation(std::unique_lock<std::mutex>& lock)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void EmulationWorker::pause()
+{
+  // This pairs with the store to myInEmulation in continuousMain: either the
+  // worker sees the request before it enters emulation, or we see it emulating
+  // and wait for the timeslice to finish.
+  myPauseRequested = true;
+  while (myInEmulation) std::this_thread::yield();
+
+  handlePossibleException();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void EmulationWorker::resume(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 minCycles, TIA* tia)
+{
+  handlePossibleException();
+
+  // The worker is paused, so the parameters can be changed without locking
+  myTia = tia;
+  myCyclesPerSecond = cyclesPerSecond;
+  myMaxCycles = maxCycles;
+  myMinCycles = minCycles;
+
+  myPauseRequested = false;
+
+  // Only wake up the worker if it actually sleeps. If it has not yet entered
+  // sleep, it will see the cleared request (see continuousMain).
+  if (myParked) {
+    const std::lock_guard<std::mutex> guard(myThreadIsRunningMutex);
+    myWakeupCondition.notify_one();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 EmulationWorker::collect(DispatchResult& dispatchResult)
+{
+  const uInt64 totalCycles = myPublishedCycles.exchange(0);
+
+  // The worker does not touch the result until it is resumed
+  if (myHalted) {
+    dispatchResult = myContinuousResult;
+    myHalted = false;
+  }
+
+  return totalCycles;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void EmulationWorker::waitForTimeslice() const
+{
+  const uInt64 timeslices = myTimeslices;
+
+  std::this_thread::sleep_until(high_resolution_clock::time_point(
+    high_resolution_clock::duration(myNextTimeslice.load(std::memory_order_relaxed))
+  ));
+
+  // The worker is due now. Give it the time of a full timeslice to finish, so that
+  // we don't pause it before it could start.
+  const duration<double> maxTimeslice(
+    static_cast<double>(myMaxCycles) / static_cast<double>(myCyclesPerSecond)
+  );
+  const auto timeout = high_resolution_clock::now() +
+    duration_cast<high_resolution_clock::duration>(maxTimeslice);
+
+  while (myTimeslices == timeslices && !myHalted && myState != State::exception &&
+         high_resolution_clock::now() < timeout)
+    std::this_thread::sleep_for(microseconds(50));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void EmulationWorker::continuousMain(std::unique_lock<std::mutex>& lock)
+{
+  myState = State::running;
+
+  while (myPendingSignal != Signal::quit) {
+    // This pairs with pause(): either we see the request here, or the main thread
+    // sees us in emulation and waits until we are done. The emulation parameters
+    // are only accessed within this window.
+    myInEmulation = true;
+
+    if (myPauseRequested || myHalted) {
+      myInEmulation = false;
+
+      // Announce that we are going to sleep before checking the request again;
+      // resume() clears the request before it checks myParked.
+      myParked = true;
+      if (myPauseRequested || myHalted) myWakeupCondition.wait(lock);
+      myParked = false;
+
+      continue;
+    }
+
+    const auto now = high_resolution_clock::now();
+    const duration<double> maxLag(
+      static_cast<double>(myMaxCycles) / static_cast<double>(myCyclesPerSecond)
+    );
+
+    if (now - myVirtualTime > duration_cast<high_resolution_clock::duration>(maxLag)) {
+      // We have been paused or can't keep up -> resync with real time
+      myVirtualTime = now;
+    }
+    else if (myVirtualTime > now) {
+      myInEmulation = false;
+
+      // Sleep until the timeslice is due (or until we are woken up to quit)
+      myWakeupCondition.wait_until(lock, myVirtualTime);
+
+      continue;
+    }
+
+    continuousTimeslice();
+
+    myInEmulation = false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void EmulationWorker::continuousTimeslice()
+{
+  uInt64 totalCycles = 0;
+
+  do {
+    myTia->update(myContinuousResult, totalCycles > 0 ? myMinCycles - totalCycles : myMaxCycles);
+    totalCycles += myContinuousResult.getCycles();
+  } while (totalCycles < myMinCycles && myContinuousResult.getStatus() == DispatchResult::Status::ok);
+
+  myPublishedCycles += totalCycles;
+
+  if (myContinuousResult.getStatus() != DispatchResult::Status::ok) {
+    // Hand over the result and wait until the main thread resumes us
+    myHalted = true;
+
+    return;
+  }
+
+  const duration<double> timesliceSeconds(static_cast<double>(totalCycles) / static_cast<double>(myCyclesPerSecond));
+  myVirtualTime += duration_cast<high_resolution_clock::duration>(timesliceSeconds);
+
+  myNextTimeslice.store(myVirtualTime.time_since_epoch().count(), std::memory_order_relaxed);
+  ++myTimeslices;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void EmulationWorker::clearSignal()
 {
@@ -33,6 +33,14 @@
  * In combination, the scheduling in the main loop and the microscheduling in the worker
  * ensure that the emulation continues to run even if rendering blocks, ensuring the real
  * time scheduling required for cycle exact audio to work.
+ *
+ * Alternatively, the worker can be created in continuous mode. In this mode, the worker
+ * is not started and stopped for each frame. Instead, it keeps emulating timeslices on its
+ * own virtual clock and publishes the emulated cycles and any dispatch result that ends
+ * emulation through atomics; finished frames are handed over by the TIA's front buffer.
+ * The main thread only pauses the worker while it polls events (which modify the
+ * emulation state) and hands over a pending frame. Pausing and resuming is a lock-free
+ * handshake; a mutex is only taken if the worker has actually gone to sleep.
  */
 
 #ifndef EMULATION_WORKER_HXX
@@ -46,9 +54,9 @@
 #include <chrono>
 
 #include "bspf.hxx"
+#include "DispatchResult.hxx"
 
 class TIA;
-class DispatchResult;
 
 class EmulationWorker
 {
@@ -56,8 +64,11 @@ class EmulationWorker
 
     /**
       The constructor starts the worker thread and waits until it has initialized.
+
+      @param continuous  Whether the worker runs continuously instead of being
+                         started and stopped for each frame
      */
-    EmulationWorker();
+    explicit EmulationWorker(bool continuous = false);
 
     /**
       The destructor signals quit to the worker and joins.
@@ -74,6 +85,38 @@ class EmulationWorker
      */
     uInt64 stop();
 
+    /**
+      Whether the worker has been created in continuous mode.
+     */
+    bool isContinuous() const { return myContinuous; }
+
+    /**
+      Continuous mode: suspend emulation after the current timeslice and wait
+      until the worker has left the emulation core.
+     */
+    void pause();
+
+    /**
+      Continuous mode: (re)start emulation with the specified parameters.
+      This must only be called while the worker is paused.
+     */
+    void resume(uInt32 cyclesPerSecond, uInt64 maxCycles, uInt64 minCycles, TIA* tia);
+
+    /**
+      Continuous mode: collect the results published since the last call. If the
+      worker has halted because of a debugger break or a fatal error, the result is
+      copied to 'dispatchResult'. This must only be called while the worker is paused.
+
+      @return  The number of 6507 cycles emulated since the last call
+     */
+    uInt64 collect(DispatchResult& dispatchResult);
+
+    /**
+      Continuous mode: sleep until the worker has emulated its next timeslice
+      (or until the time allotted to it has passed).
+     */
+    void waitForTimeslice() const;
+
   private:
 
     /**
@@ -87,6 +130,16 @@ class EmulationWorker
      */
     void threadMain(std::condition_variable* initializedCondition, std::mutex* initializationMutex);
 
+    /**
+      The loop of the worker thread in continuous mode.
+     */
+    void continuousMain(std::unique_lock<std::mutex>& lock);
+
+    /**
+      Continuous mode: emulate a single timeslice and publish the result.
+     */
+    void continuousTimeslice();
+
     /**
       Handle thread wakeup after sleep depending on the thread state.
      */
@@ -199,6 +252,25 @@ class EmulationWorker
     // 6507 time
     std::chrono::time_point<std::chrono::high_resolution_clock> myVirtualTime;
 
+    // Continuous mode
+    const bool myContinuous{false};
+    // Set by the main thread to keep the worker out of the emulation core
+    std::atomic<bool> myPauseRequested{true};
+    // Set by the worker while it is emulating
+    std::atomic<bool> myInEmulation{false};
+    // Set by the worker while it sleeps waiting for myWakeupCondition
+    std::atomic<bool> myParked{false};
+    // Set by the worker after a timeslice ended with a debugger break or a fatal
+    // error; the main thread takes over myContinuousResult from this point
+    std::atomic<bool> myHalted{false};
+    DispatchResult myContinuousResult;
+    // 6507 cycles emulated since the main thread last collected them
+    std::atomic<uInt64> myPublishedCycles{0};
+    // The number of timeslices emulated and the worker's virtual clock,
+    // published for the main thread
+    std::atomic<uInt64> myTimeslices{0};
+    std::atomic<std::chrono::high_resolution_clock::rep> myNextTimeslice{0};
+
   private:
 
     EmulationWorker(const EmulationWorker&) = delete;
@@ -336,6 +336,12 @@ size_t FSNode::getSize() const
   return (_realNode && _realNode->exists()) ? _realNode->getSize() : 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 FSNode::getModifiedTime() const
+{
+  return _realNode ? _realNode->getModifiedTime() : 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 size_t FSNode::read(ByteBuffer& buffer, size_t size) const
 {
@@ -24,6 +24,8 @@
 #include "OSystem.hxx"
 #include "Settings.hxx"
 #include "TIA.hxx"
+#include "System.hxx"
+#include "M6502.hxx"
 #include "Sound.hxx"
 #include "AudioSettings.hxx"
 #include "MediaFactory.hxx"
@@ -725,6 +727,10 @@ void FrameBuffer::drawFrameStats(float framesPerSecond)
         ? 20.0F
         : myOSystem.settings().getFloat("speed"))
     << "% speed";
+  if(myTIASurface->ntscEnabled())
+    ss
+      << " | " << std::fixed << std::setprecision(2)
+      << myTIASurface->ntsc().renderTime() << "ms TV";
 
   myStatsMsg.surface->drawString(f, ss.str(), xPos, yPos,
       myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
@@ -733,6 +739,18 @@ void FrameBuffer::drawFrameStats(float framesPerSecond)
   ss.str("");
 
   ss << info.BankSwitch;
+
+  // Share of CPU cycles skipped in idle loops since the last frame
+  const M6502& cpu = myOSystem.console().system().m6502();
+  const uInt64 cycles = myOSystem.console().tia().cycles();
+  if(myOSystem.settings().getBool("idleskip") && cycles > myLastStatsCycles &&
+     cpu.idleCyclesSkipped() >= myLastIdleCycles)
+    ss << " | " << std::fixed << std::setprecision(0)
+       << 100.0 * (cpu.idleCyclesSkipped() - myLastIdleCycles) / (cycles - myLastStatsCycles)
+       << "% idle";
+  myLastIdleCycles = cpu.idleCyclesSkipped();
+  myLastStatsCycles = cycles;
+
   int xPosEnd =
     myStatsMsg.surface->drawString(f, ss.str(), xPos, yPos,
                                    myStatsMsg.w, myStatsMsg.color, TextAlign::Left, 0, true, kBGColor);
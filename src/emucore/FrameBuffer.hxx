@@ -583,6 +583,7 @@ class FrameBuffer
     Message myStatsMsg;
     bool myStatsEnabled{false};
     uInt32 myLastScanlines{0};
+    uInt64 myLastIdleCycles{0}, myLastStatsCycles{0};
 
     bool myGrabMouse{false};
     vector<bool> myHiDPIAllowed;
@@ -97,6 +97,9 @@ void M6502::reset()
   myLogBreaks = mySettings.getBool("dbg.logbreaks");
 
   myLastBreakCycle = ULLONG_MAX;
+
+  myIdleSkipping = mySettings.getBool("idleskip");
+  myIdleCyclesSkipped = myIdleLoopsSkipped = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -191,7 +194,24 @@ inline void M6502::handleHalt()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::execute(uInt64 cycles, DispatchResult& result)
 {
-  _execute(cycles, result);
+#ifdef DEBUGGER_SUPPORT
+  switch(dispatchMode())
+  {
+    case DispatchMode::plain:
+      _execute<DispatchMode::plain>(cycles, result);
+      break;
+
+    case DispatchMode::traps:
+      _execute<DispatchMode::traps>(cycles, result);
+      break;
+
+    case DispatchMode::full:
+      _execute<DispatchMode::full>(cycles, result);
+      break;
+  }
+#else
+  _execute<DispatchMode::plain>(cycles, result);
+#endif
 
 #ifdef DEBUGGER_SUPPORT
   // Debugger hack: this ensures that stepping a "STA WSYNC" will actually end at the
@@ -220,6 +240,7 @@ bool M6502::execute(uInt64 cycles)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // NOLINTNEXTLINE (readability-function-size)
+template<M6502::DispatchMode mode>
 inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
 {
   myExecutionStatus = 0;
@@ -239,7 +260,7 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
     {
   #ifdef DEBUGGER_SUPPORT
       // Don't break if we haven't actually executed anything yet
-      if (myLastBreakCycle != mySystem->cycles()) {
+      if (mode != DispatchMode::plain && myLastBreakCycle != mySystem->cycles()) {
         if(myJustHitReadTrapFlag || myJustHitWriteTrapFlag)
         {
           const bool read = myJustHitReadTrapFlag;
@@ -258,73 +279,79 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
           }
         }
 
-        if(myBreakPoints.isInitialized())
+        if constexpr(mode == DispatchMode::full)
         {
-          const uInt8 bank = mySystem->cart().getBank(PC);
-
-          if(myBreakPoints.check(PC, bank))
+          if(myBreakPoints.checkAddress(PC))
           {
-            myLastBreakCycle = mySystem->cycles();
-            const uInt32 flags = myBreakPoints.get(PC, bank);
+            const uInt8 bank = mySystem->cart().getBank(PC);
 
-            // disable a one-shot breakpoint
-            if(flags & BreakpointMap::ONE_SHOT)
-            {
-              myBreakPoints.erase(PC, bank);
-              return;
-            }
-            else
+            if(myBreakPoints.check(PC, bank))
             {
-              if(myLogBreaks)
+              myLastBreakCycle = mySystem->cycles();
+              const uInt32 flags = myBreakPoints.get(PC, bank);
+
+              // disable a one-shot breakpoint
+              if(flags & BreakpointMap::ONE_SHOT)
               {
-                // Make sure that the TIA state matches the current system clock.
-                // Else Scanlines, Cycles and Pixels are not updated for logging.
-                mySystem->tia().updateEmulation();
-                myDebugger->log("BP:");
+                myBreakPoints.erase(PC, bank);
+                return;
               }
               else
               {
-                ostringstream msg;
-
-                msg << "BP: $" << Common::Base::HEX4 << PC << ", bank #"
-                    << std::dec << static_cast<int>(bank);
-                result.setDebugger(currentCycles, msg.str(), "Breakpoint");
-                return;
+                if(myLogBreaks)
+                {
+                  // Make sure that the TIA state matches the current system clock.
+                  // Else Scanlines, Cycles and Pixels are not updated for logging.
+                  mySystem->tia().updateEmulation();
+                  myDebugger->log("BP:");
+                }
+                else
+                {
+                  ostringstream msg;
+
+                  msg << "BP: $" << Common::Base::HEX4 << PC << ", bank #"
+                      << std::dec << static_cast<int>(bank);
+                  result.setDebugger(currentCycles, msg.str(), "Breakpoint");
+                  return;
+                }
               }
             }
           }
-        }
 
-        if(myTimer.isInitialized())
-          myTimer.update(PC, mySystem->cart().getBank(PC), mySystem->cycles());
+          if(myTimer.isInitialized())
+            myTimer.update(PC, mySystem->cart().getBank(PC), mySystem->cycles());
 
-        const int cond = evalCondBreaks();
-        if(cond > -1)
-        {
-          ostringstream msg;
+          const int cond = evalCondBreaks();
+          if(cond > -1)
+          {
+            ostringstream msg;
 
-          myLastBreakCycle = mySystem->cycles();
+            myLastBreakCycle = mySystem->cycles();
 
-          if(myLogBreaks)
-          {
-            msg << "CBP[" << Common::Base::HEX2 << cond << "]:";
-            myDebugger->log(msg.str());
-          }
-          else
-          {
-            msg << "CBP[" << Common::Base::HEX2 << cond << "]: " << myCondBreakNames[cond];
-            result.setDebugger(currentCycles, msg.str(), "Conditional breakpoint");
-            return;
+            if(myLogBreaks)
+            {
+              msg << "CBP[" << Common::Base::HEX2 << cond << "]:";
+              myDebugger->log(msg.str());
+            }
+            else
+            {
+              msg << "CBP[" << Common::Base::HEX2 << cond << "]: " << myCondBreakNames[cond];
+              result.setDebugger(currentCycles, msg.str(), "Conditional breakpoint");
+              return;
+            }
           }
         }
       }
 
-      const int cond = evalCondSaveStates();
-      if(cond > -1)
+      if constexpr(mode == DispatchMode::full)
       {
-        ostringstream msg;
-        msg << "conditional savestate [" << Common::Base::HEX2 << cond << "]";
-        myDebugger->addState(msg.str());
+        const int cond = evalCondSaveStates();
+        if(cond > -1)
+        {
+          ostringstream msg;
+          msg << "conditional savestate [" << Common::Base::HEX2 << cond << "]";
+          myDebugger->addState(msg.str());
+        }
       }
 
       mySystem->cart().clearAllRAMAccesses();
@@ -333,14 +360,39 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
       // Reset the data poke address pointer
       myDataAddressForPoke = 0;
 
+      const uInt16 oldPC = PC;
+
+  #ifdef DEBUGGER_SUPPORT
+      TraceBuffer::Record* traceRecord = nullptr;
+      uInt8 bank = 0;
+      uInt32 frameCycles = 0;
+
+      if(mode == DispatchMode::full && myProfiler.isEnabled())
+      {
+        bank = mySystem->cart().getBank(PC);
+        frameCycles = tia.frameCycles();
+      }
+      if(mode == DispatchMode::full && myTraceBuffer.isEnabled())
+      {
+        traceRecord = &myTraceBuffer.next();
+        traceRecord->cycles = mySystem->cycles();
+        traceRecord->pc = PC;
+        traceRecord->bank = mySystem->cart().getBank(PC);
+        traceRecord->a = A;
+        traceRecord->x = X;
+        traceRecord->y = Y;
+        traceRecord->sp = SP;
+        traceRecord->ps = PS();
+        traceRecord->codeBytes = peekOperand(PC);
+      }
+  #endif
+
       try {
         uInt16 operandAddress = 0, intermediateAddress = 0;
         uInt8 operand = 0;
 
         icycles = 0;
     #ifdef DEBUGGER_SUPPORT
-        const uInt16 oldPC = PC;
-
         // Only check for code in RAM execution if we have debugger support
         if(!mySystem->cart().canExecute(PC))
           FatalEmulationError::raise("cannot run code from cart RAM");
@@ -360,7 +412,15 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
         }
 
     #ifdef DEBUGGER_SUPPORT
-        if(myReadFromWritePortBreak)
+        if(traceRecord)
+        {
+          traceRecord->opcode = IR;
+          traceRecord->operand = operand;
+          traceRecord->peekAddress = myLastPeekAddress;
+          traceRecord->pokeAddress = myLastPokeAddress;
+        }
+
+        if(mode != DispatchMode::plain && myReadFromWritePortBreak)
         {
           const uInt16 rwpAddr = mySystem->cart().getIllegalRAMReadAccess();
           if(rwpAddr)
@@ -372,7 +432,7 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
           }
         }
 
-        if (myWriteToReadPortBreak)
+        if (mode != DispatchMode::plain && myWriteToReadPortBreak)
         {
           const uInt16 wrpAddr = mySystem->cart().getIllegalRAMWriteAccess();
           if (wrpAddr)
@@ -392,10 +452,20 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
         return;
       }
 
+  #ifdef DEBUGGER_SUPPORT
+      if(mode == DispatchMode::full && myProfiler.isEnabled())
+        myProfiler.add(bank, oldPC, icycles, frameCycles);
+  #endif
+
       currentCycles = (mySystem->cycles() - previousCycles);
 
+      // A backward jump or branch may close an idle loop which can be skipped
+      if(myIdleSkipping && PC <= oldPC && !myExecutionStatus &&
+         currentCycles < cycles * SYSTEM_CYCLES_PER_CPU)
+        currentCycles += skipIdleLoop(oldPC, cycles * SYSTEM_CYCLES_PER_CPU - currentCycles);
+
   #ifdef DEBUGGER_SUPPORT
-      if(myStepStateByInstruction)
+      if(mode == DispatchMode::full && myStepStateByInstruction)
       {
         // Check out M6502::execute for an explanation.
         handleHalt();
@@ -438,6 +508,127 @@ inline void M6502::_execute(uInt64 cycles, DispatchResult& result)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 M6502::skipIdleLoop(uInt16 jumpPC, uInt64 maxCycles)
+{
+#ifdef DEBUGGER_SUPPORT
+  // Everything the debugger checks per instruction requires full emulation
+  if(myStepStateByInstruction || myBreakPoints.isInitialized() ||
+     myReadTraps.isInitialized() || myWriteTraps.isInitialized() ||
+     myTimer.isInitialized() || myTraceBuffer.isEnabled() ||
+     myProfiler.isEnabled())
+    return 0;
+#endif
+  if(myHaltRequested)
+    return 0;
+
+  const auto isBranch = [](uInt8 opcode) { return (opcode & 0x1f) == 0x10; };
+  if(!isBranch(IR) && IR != 0x4c)  // JMP abs
+    return 0;
+
+  // The loop must be read directly from memory (so that fetching it has no
+  // side effects) and must not cross a page (so that the branch timing
+  // is fixed)
+  const uInt16 head = PC;
+  const System::PageAccess& access = mySystem->getPageAccess(head);
+  if(!access.directPeekBase ||
+     ((head ^ (jumpPC + 2)) & ~static_cast<uInt32>(System::PAGE_MASK)))
+    return 0;
+
+  // Each iteration takes the same number of cycles and memory accesses (all
+  // of them to distinct addresses). Only complete iterations are skipped,
+  // the rest of the timeslice is emulated normally.
+  uInt32 loopCycles = 0;
+  uInt64 iterations = 0;
+  M6532& riot = mySystem->m6532();
+  bool pollsTimer = false;
+
+  if(jumpPC == head)
+  {
+    // Branch or jump to itself, loops until the end of the timeslice
+    loopCycles = 3;
+    iterations = maxCycles / loopCycles;
+  }
+  else if(jumpPC == head + 3 && isBranch(IR))
+  {
+    // Reading the RIOT timer (LDA/LDX/LDY/BIT abs), followed by a branch
+    const uInt8* code = access.directPeekBase + (head & System::PAGE_MASK);
+    const uInt8 opcode = code[0];
+    const uInt16 address = code[1] | (code[2] << 8);
+
+    if(opcode != 0xad && opcode != 0xae && opcode != 0xac && opcode != 0x2c)
+      return 0;
+
+    const System::PageAccess& ioAccess = mySystem->getPageAccess(address);
+    if(ioAccess.directPeekBase || ioAccess.device != &riot ||
+       (address & 0x0204) != 0x0204)
+      return 0;
+
+    // The timer is read in the 4th cycle of each iteration, count the
+    // iterations reading the same value
+    constexpr uInt32 readCycle = 4;
+    uInt8 value = 0;
+    const uInt32 stableCycles = riot.stableTimerCycles(address & 0x01, value);
+    if(stableCycles <= readCycle)
+      return 0;
+
+    loopCycles = 7;
+    iterations = std::min<uInt64>((stableCycles - readCycle - 1) / loopCycles + 1,
+                                  maxCycles / loopCycles);
+
+    // Determine the flags resulting from the read, the loop only continues
+    // if the branch is taken
+    const bool n = value & 0x80;
+    const bool v = opcode == 0x2c ? value & 0x40 : V;
+    const bool z = opcode == 0x2c ? !(A & value) : !value;
+    bool taken = false;
+
+    switch(IR >> 6)
+    {
+      case 0:  taken = n; break;
+      case 1:  taken = v; break;
+      case 2:  taken = C; break;
+      default: taken = z; break;
+    }
+    if(taken != static_cast<bool>(IR & 0x20))
+      return 0;
+
+    switch(opcode)
+    {
+      case 0xad:
+        A = value;
+        SET_LAST_PEEK(myLastSrcAddressA, address)
+        break;
+      case 0xae:
+        X = value;
+        SET_LAST_PEEK(myLastSrcAddressX, address)
+        break;
+      case 0xac:
+        Y = value;
+        SET_LAST_PEEK(myLastSrcAddressY, address)
+        break;
+      default:
+        break;
+    }
+    N = n;  V = v;  notZ = !z;
+    pollsTimer = true;
+  }
+  else
+    return 0;
+
+  const uInt64 skippedCycles = iterations * loopCycles;
+
+  mySystem->incrementCycles(static_cast<uInt32>(skippedCycles));
+  myNumberOfDistinctAccesses += static_cast<uInt32>(skippedCycles);
+  if(pollsTimer)
+    riot.skipTimerReads(iterations);
+
+  myIdleCyclesSkipped += skippedCycles;
+  ++myIdleLoopsSkipped;
+
+  return skippedCycles;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::interruptHandler()
 {
@@ -695,6 +886,47 @@ const StringList& M6502::getCondTrapNames() const
   return myTrapCondNames;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+M6502::DispatchMode M6502::dispatchMode() const
+{
+  if(myBreakPoints.size() || myTimer.isInitialized() || myStepStateByInstruction ||
+     myTraceBuffer.isEnabled() || myProfiler.isEnabled())
+    return DispatchMode::full;
+
+  if(myReadTraps.isInitialized() || myWriteTraps.isInitialized() ||
+     myJustHitReadTrapFlag || myJustHitWriteTrapFlag ||
+     myReadFromWritePortBreak || myWriteToReadPortBreak)
+    return DispatchMode::traps;
+
+  return DispatchMode::plain;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt16 M6502::peekOperand(uInt16 pc)
+{
+  Cartridge& cart = mySystem->cart();
+  const bool hotspotsLocked = cart.hotspotsLocked();
+
+  // Like the debugger, lock the system so that reading has no side effects
+  mySystem->lockDataBus();
+  cart.lockHotspots();
+
+  const auto peekCode = [&](uInt16 address) -> uInt16 {
+    const System::PageAccess& access = mySystem->getPageAccess(address);
+
+    return access.directPeekBase
+      ? access.directPeekBase[address & System::PAGE_MASK]
+      : mySystem->peek(address);
+  };
+  const uInt16 operand = static_cast<uInt16>(peekCode(pc + 1) | (peekCode(pc + 2) << 8));
+
+  mySystem->unlockDataBus();
+  if(!hotspotsLocked)
+    cart.unlockHotspots();
+
+  return operand;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::updateStepStateByInstruction()
 {
@@ -30,6 +30,8 @@ class DispatchResult;
 
   #include "Expression.hxx"
   #include "TrapArray.hxx"
+  #include "TraceBuffer.hxx"
+  #include "CpuProfiler.hxx"
   #include "BreakpointMap.hxx"
   #include "TimerMap.hxx"
 #endif
@@ -209,6 +211,15 @@ class M6502 : public Serializable
     */
     uInt32 distinctAccesses() const { return myNumberOfDistinctAccesses; }
 
+    /**
+      Get the number of cycles skipped by idle loop detection, and the number
+      of times an idle loop was skipped
+
+      @return The number of skipped cycles resp. loops since the last reset
+    */
+    uInt64 idleCyclesSkipped() const { return myIdleCyclesSkipped; }
+    uInt64 idleLoopsSkipped() const { return myIdleLoopsSkipped; }
+
     /**
       Saves the current state of this device to the given Serializer.
 
@@ -235,6 +246,10 @@ class M6502 : public Serializable
 
     BreakpointMap& breakPoints() { return myBreakPoints; }
 
+    TraceBuffer& traceBuffer() { return myTraceBuffer; }
+
+    CpuProfiler& profiler() { return myProfiler; }
+
     // methods for 'breakif' handling
     uInt32 addCondBreak(Expression* e, string_view name, bool oneShot = false);
     bool delCondBreak(uInt32 idx);
@@ -338,18 +353,58 @@ class M6502 : public Serializable
     */
     void handleHalt();
 
+    /**
+      The debugger features which have to be checked for each instruction
+    */
+    enum class DispatchMode {
+      plain,  // none
+      traps,  // read/write traps and illegal cart RAM accesses
+      full    // all, including breakpoints, timers and conditions
+    };
+
     /**
       This is the actual dispatch function that does the grunt work. M6502::execute
       wraps it and makes sure that any pending halt is processed before returning.
+      It is compiled for each dispatch mode, so that unused debugger features
+      cost nothing.
     */
+    template<DispatchMode mode>
     void _execute(uInt64 cycles, DispatchResult& result);
 
+    /**
+      Called after a backward jump or branch was taken. If it closes an idle
+      loop (a branch or jump to itself, or a loop only polling the RIOT timer),
+      the iterations which would run without any change are skipped by
+      advancing the system clock and the CPU state accordingly.
+
+      @param jumpPC     The address of the jump/branch instruction
+      @param maxCycles  The number of cycles left to execute
+      @return  The number of cycles skipped
+    */
+    uInt64 skipIdleLoop(uInt16 jumpPC, uInt64 maxCycles);
+
 #ifdef DEBUGGER_SUPPORT
     /**
       Check whether we are required to update hardware (TIA + RIOT) in lockstep
       with the CPU and update the flag accordingly.
     */
     void updateStepStateByInstruction();
+
+    /**
+      Determine the dispatch mode required by the debugger features
+      currently in use.
+    */
+    DispatchMode dispatchMode() const;
+
+    /**
+      Read the two bytes following the opcode at the given address without
+      any side effects, i.e. the operand of the instruction.  This must be
+      done before the instruction is executed, since it may switch banks.
+
+      @param pc  The address of the opcode
+      @return  The operand bytes, little endian
+    */
+    uInt16 peekOperand(uInt16 pc);
 #endif  // DEBUGGER_SUPPORT
 
   private:
@@ -427,10 +482,16 @@ class M6502 : public Serializable
     /// Indicates whether RDY was pulled low
     bool myHaltRequested{false};
 
+    /// Indicates whether idle loops are detected and skipped
+    bool myIdleSkipping{false};
+
+    /// The number of cycles skipped in idle loops and the number of skips
+    uInt64 myIdleCyclesSkipped{0}, myIdleLoopsSkipped{0};
+
 #ifdef DEBUGGER_SUPPORT
     Int32 evalCondBreaks() {
       for(Int32 i = static_cast<Int32>(myCondBreaks.size()) - 1; i >= 0; --i)
-        if(myCondBreaks[i]->evaluate())
+        if(myCondBreaks[i].evaluate())
           return i;
 
       return -1; // no break hit
@@ -439,7 +500,7 @@ class M6502 : public Serializable
     Int32 evalCondSaveStates()
     {
       for(Int32 i = static_cast<Int32>(myCondSaveStates.size()) - 1; i >= 0; --i)
-        if(myCondSaveStates[i]->evaluate())
+        if(myCondSaveStates[i].evaluate())
           return i;
 
       return -1; // no save state point hit
@@ -448,7 +509,7 @@ class M6502 : public Serializable
     Int32 evalCondTraps()
     {
       for(Int32 i = static_cast<Int32>(myTrapConds.size()) - 1; i >= 0; --i)
-        if(myTrapConds[i]->evaluate())
+        if(myTrapConds[i].evaluate())
           return i;
 
       return -1; // no trapif hit
@@ -470,15 +531,19 @@ class M6502 : public Serializable
     HitTrapInfo myHitTrapInfo;
 
     BreakpointMap myBreakPoints;
-    vector<unique_ptr<Expression>> myCondBreaks;
+    vector<CompiledExpression> myCondBreaks;
     StringList myCondBreakNames;
-    vector<unique_ptr<Expression>> myCondSaveStates;
+    vector<CompiledExpression> myCondSaveStates;
     StringList myCondSaveStateNames;
-    vector<unique_ptr<Expression>> myTrapConds;
+    vector<CompiledExpression> myTrapConds;
     StringList myTrapCondNames;
 
     TimerMap myTimer;
 
+    TraceBuffer myTraceBuffer;
+
+    CpuProfiler myProfiler;
+
 #endif  // DEBUGGER_SUPPORT
 
     bool myGhostReadsTrap{false};          // trap on ghost reads
@@ -370,6 +370,33 @@ void M6532::setPinState(bool swcha)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 M6532::stableTimerCycles(bool timint, uInt8& value)
+{
+  updateEmulation();
+
+  // Reads clear the flags, so they only have no side effects while both
+  // flags are cleared already
+  if(myInterruptFlag != 0)
+    return 0;
+
+  // The timer decrements every time the divider has counted down,
+  // TIMINT changes only when the timer wraps
+  const uInt32 nextTick = myDivider - mySubTimer;
+
+  value = timint ? myInterruptFlag : myTimer;
+
+  return timint ? nextTick + myTimer * myDivider : nextTick;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6532::skipTimerReads(uInt32 count)
+{
+#ifdef DEBUGGER_SUPPORT
+  myTimReadCycles += 7 * count;
+#endif
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool M6532::save(Serializer& out) const
 {
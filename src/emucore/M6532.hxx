@@ -130,6 +130,25 @@ class M6532 : public Device
     */
     const uInt8* getRAM() const { return myRAM.data(); }
 
+    /**
+      Answers for how many CPU cycles from now on reads of the timer
+      (INTIM or TIMINT) return the same value without changing any state.
+      Used by the CPU to skip loops polling the timer.
+
+      @param timint  Whether TIMINT (else INTIM) is read
+      @param value   Returns the value these reads return
+
+      @return  Number of cycles, 0 if the reads have side effects
+    */
+    uInt32 stableTimerCycles(bool timint, uInt8& value);
+
+    /**
+      Account for the given number of timer reads skipped by the CPU.
+
+      @param count  The number of skipped reads
+    */
+    void skipTimerReads(uInt32 count);
+
   #ifdef DEBUGGER_SUPPORT
     /**
       Query the access counters
@@ -278,11 +278,11 @@ string MD5::hash(const ByteBuffer& buffer, size_t length)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string MD5::hash(const uInt8* buffer, size_t length)
 {
-  static MD5 ourMD5;  // singleton
+  MD5 md5;  // not shared, so hashing is thread-safe
 
-  ourMD5.init();
-  ourMD5.update(buffer, static_cast<uInt32>(length));
-  ourMD5.finalize();
+  md5.init();
+  md5.update(buffer, static_cast<uInt32>(length));
+  md5.finalize();
 
-  return ourMD5.hexdigest();
+  return md5.hexdigest();
 }
@@ -61,6 +61,7 @@
 #include "TimerManager.hxx"
 #ifdef GUI_SUPPORT
   #include "HighScoresManager.hxx"
+  #include "RomIndexer.hxx"
 #endif
 #include "Version.hxx"
 #include "TIA.hxx"
@@ -195,6 +196,7 @@ bool OSystem::initialize(const Settings::Options& options)
   myLauncher = make_unique<Launcher>(*this);
 
   myHighScoresManager->setRepository(getHighscoreRepository());
+  myRomIndexer = make_unique<RomIndexer>(getRomIndexRepository());
 #endif
 
 #ifdef IMAGE_SUPPORT
@@ -908,7 +910,64 @@ double OSystem::dispatchEmulation(EmulationWorker& emulationWorker)
   // Stop the worker and wait until it has finished
   const uInt64 totalCycles = emulationWorker.stop();
 
-  // Handle the dispatch result
+  handleDispatchResult(dispatchResult);
+
+  // Handle frying
+  if (dispatchResult.getStatus() == DispatchResult::Status::ok &&
+      myEventHandler->frying())
+    myConsole->fry();
+
+  // Return the 6507 time used in seconds
+  return static_cast<double>(totalCycles) /
+      static_cast<double>(timing.cyclesPerSecond());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::dispatchContinuousEmulation(EmulationWorker& emulationWorker)
+{
+  if (!myConsole) return;
+
+  TIA& tia(myConsole->tia());
+  const EmulationTiming& timing = myConsole->emulationTiming();
+  DispatchResult dispatchResult;
+
+  // The worker has been paused by the main loop while polling events. Collect
+  // what it has emulated in the meantime...
+  const uInt64 totalCycles = emulationWorker.collect(dispatchResult);
+  if (dispatchResult.getStatus() == DispatchResult::Status::invalid)
+    dispatchResult.setOk(totalCycles);
+
+  // ... and take over the last finished frame
+  const bool framePending = tia.newFramePending();
+  if (framePending) {
+    myFpsMeter.render(tia.framesSinceLastRender());
+    tia.renderToFrameBuffer();
+  }
+
+  if (dispatchResult.getStatus() == DispatchResult::Status::ok) {
+    // Handle frying
+    if (myEventHandler->frying())
+      myConsole->fry();
+
+    // Let the worker continue; it does its own scheduling and will only be
+    // paused again for the next round of event polling
+    emulationWorker.resume(
+      timing.cyclesPerSecond(),
+      timing.maxCyclesPerTimeslice(),
+      timing.minCyclesPerTimeslice(),
+      &tia
+    );
+  }
+
+  // Render the frame while the worker keeps emulating
+  if (framePending) myFrameBuffer->updateInEmulationMode(myFpsMeter.fps());
+
+  handleDispatchResult(dispatchResult);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::handleDispatchResult(const DispatchResult& dispatchResult)
+{
   switch (dispatchResult.getStatus()) {
     case DispatchResult::Status::ok:
       break;
@@ -936,15 +995,6 @@ double OSystem::dispatchEmulation(EmulationWorker& emulationWorker)
     default:
       throw runtime_error("invalid emulation dispatch result");
   }
-
-  // Handle frying
-  if (dispatchResult.getStatus() == DispatchResult::Status::ok &&
-      myEventHandler->frying())
-    myConsole->fry();
-
-  // Return the 6507 time used in seconds
-  return static_cast<double>(totalCycles) /
-      static_cast<double>(timing.cyclesPerSecond());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -953,7 +1003,7 @@ void OSystem::mainLoop()
   // 6507 time
   time_point<high_resolution_clock> virtualTime = high_resolution_clock::now();
   // The emulation worker
-  EmulationWorker emulationWorker;
+  EmulationWorker emulationWorker(mySettings->getBool("freerun"));
 
   myFpsMeter.reset(TIAConstants::initialGarbageFrames);
 
@@ -961,6 +1011,9 @@ void OSystem::mainLoop()
   {
     const bool wasEmulation = myEventHandler->state() == EventHandlerState::EMULATION;
 
+    // A continuously running worker must not emulate while events are processed
+    if (emulationWorker.isContinuous()) emulationWorker.pause();
+
     myEventHandler->poll(TimerManager::getTicks());
     if(myQuitLoop) break;  // Exit if the user wants to quit
 
@@ -969,6 +1022,18 @@ void OSystem::mainLoop()
       virtualTime = high_resolution_clock::now();
     }
 
+    if (emulationWorker.isContinuous() &&
+        myEventHandler->state() == EventHandlerState::EMULATION)
+    {
+      // Hand over the frame and render it, then sleep until the worker has
+      // emulated its next timeslice
+      dispatchContinuousEmulation(emulationWorker);
+      emulationWorker.waitForTimeslice();
+      virtualTime = high_resolution_clock::now();
+
+      continue;
+    }
+
     double timesliceSeconds;  // NOLINT
 
     if (myEventHandler->state() == EventHandlerState::EMULATION)
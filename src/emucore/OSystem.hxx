@@ -29,6 +29,7 @@ class StateManager;
 class TimerManager;
 class HighScoresManager;
 class EmulationWorker;
+class DispatchResult;
 class AudioSettings;
 #ifdef CHEATCODE_SUPPORT
   class CheatManager;
@@ -45,6 +46,7 @@ class AudioSettings;
   class PlusRomsMenu;
   class TimeMachine;
   class VideoAudioDialog;
+  class RomIndexer;
 #endif
 #ifdef IMAGE_SUPPORT
   class PNGLibrary;
@@ -158,6 +160,13 @@ class OSystem
       @return The highscore manager object
     */
     HighScoresManager& highScores() const { return *myHighScoresManager; }
+
+    /**
+      Get the ROM indexer of the system.
+
+      @return The ROM indexer object
+    */
+    RomIndexer& romIndexer() const { return *myRomIndexer; }
   #endif
 
     /**
@@ -356,6 +365,20 @@ class OSystem
     */
     static string getROMMD5(const FSNode& rom);
 
+    /**
+      Open the given ROM and return an array containing its contents.
+      This method takes care of using only a valid size for the
+
+      @param romfile  The file node of the ROM to open (contains path)
+      @param size     The amount of data read into the image array
+      @param showErrorMessage  Whether to show (or ignore) any errors
+                               when opening the ROM
+
+      @return  Unique pointer to the array, otherwise nullptr
+    */
+    static ByteBuffer openROM(const FSNode& romfile, size_t& size,
+                              bool showErrorMessage);
+
     /**
       Creates a new game console from the specified romfile, and correctly
       initializes the system state to start emulation of the Console.
@@ -486,6 +509,8 @@ class OSystem
 
     virtual shared_ptr<CompositeKeyValueRepositoryAtomic> getHighscoreRepository() = 0;
 
+    virtual shared_ptr<KeyValueRepositoryAtomic> getRomIndexRepository() = 0;
+
   protected:
 
     //////////////////////////////////////////////////////////////////////
@@ -587,6 +612,9 @@ class OSystem
   #ifdef GUI_SUPPORT
     // Pointer to the HighScoresManager object
     unique_ptr<HighScoresManager> myHighScoresManager;
+
+    // Pointer to the RomIndexer object
+    unique_ptr<RomIndexer> myRomIndexer;
   #endif
 
     // Indicates whether ROM launcher was ever opened during this run
@@ -629,19 +657,6 @@ class OSystem
     */
     void createSound();
 
-    /**
-      Open the given ROM and return an array containing its contents.
-      This method takes care of using only a valid size for the
-
-      @param romfile  The file node of the ROM to open (contains path)
-      @param size     The amount of data read into the image array
-      @param showErrorMessage  Whether to show (or ignore) any errors
-                               when opening the ROM
-
-      @return  Unique pointer to the array, otherwise nullptr
-    */
-    static ByteBuffer openROM(const FSNode& romfile, size_t& size,
-                              bool showErrorMessage);
 
     /**
       Creates an actual Console object based on the given info.
@@ -668,6 +683,17 @@ class OSystem
 
     double dispatchEmulation(EmulationWorker& emulationWorker);
 
+    /**
+      Hand over the frame and the results of a continuously running emulation
+      worker and let it continue. The worker must have been paused.
+    */
+    void dispatchContinuousEmulation(EmulationWorker& emulationWorker);
+
+    /**
+      Start the debugger or report an error, depending on the dispatch result.
+    */
+    void handleDispatchResult(const DispatchResult& dispatchResult);
+
     // Following constructors and assignment operators not supported
     OSystem(const OSystem&) = delete;
     OSystem(OSystem&&) = delete;
@@ -49,6 +49,12 @@ shared_ptr<CompositeKeyValueRepositoryAtomic> OSystemStandalone::getHighscoreRep
   return {myStellaDb, &myStellaDb->highscoreRepository()};
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+shared_ptr<KeyValueRepositoryAtomic> OSystemStandalone::getRomIndexRepository()
+{
+  return {myStellaDb, &myStellaDb->romIndexRepository()};
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void OSystemStandalone::getBaseDirectories(
     string& basedir, string& homedir, bool useappdir, string_view usedir)
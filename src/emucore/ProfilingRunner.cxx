@@ -17,9 +17,13 @@
 
 #include <chrono>
 #include <cmath>
+#include <atomic>
+#include <thread>
+#include <fstream>
 
 #include "ProfilingRunner.hxx"
 #include "FSNode.hxx"
+#include "Bankswitch.hxx"
 #include "Cart.hxx"
 #include "CartCreator.hxx"
 #include "MD5.hxx"
@@ -35,8 +39,11 @@
 #include "Joystick.hxx"
 #include "Random.hxx"
 #include "DispatchResult.hxx"
+#include "Logger.hxx"
+#include "json_lib.hxx"
 
 using namespace std::chrono;
+using json = nlohmann::json;
 
 namespace {
   constexpr uInt32 RUNTIME_DEFAULT = 60;
@@ -51,71 +58,219 @@ namespace {
       from++;
     }
   }
+
+  void collectRoms(const FSNode& node, vector<string>& roms) {
+    if (!node.isDirectory()) {
+      roms.push_back(node.getPath());
+      return;
+    }
+
+    FSList children;
+    node.getChildren(children, FSNode::ListMode::All,
+      [](const FSNode& child) {
+        return child.isDirectory() || Bankswitch::isValidRomName(child);
+      }, false, false);
+
+    for (const FSNode& child : children) collectRoms(child, roms);
+  }
 } // namespace
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ProfilingRunner::ProfilingRunner(int argc, char* argv[])
-  : profilingRuns{std::max<size_t>(argc - 2, 0)}
+  : myBenchmark{argc > 1 && string(argv[1]) == "-benchmark"}
 {
   for (int i = 2; i < argc; i++) {
-    ProfilingRun& run(profilingRuns[i-2]);
-
     const string arg = argv[i];
-    const size_t splitPoint = arg.find_first_of(':');
 
-    run.romFile = splitPoint == string::npos ? arg : arg.substr(0, splitPoint);
+    if (myBenchmark && arg == "-threads" && i + 1 < argc)
+      myNumThreads = std::max(BSPF::stoi(argv[++i]), 0);
+    else if (myBenchmark && arg == "-out" && i + 1 < argc)
+      myOutFile = argv[++i];
+    else
+      addRun(arg);
+  }
 
-    if (splitPoint == string::npos) run.runtime = RUNTIME_DEFAULT;
-    else  {
-      const int runtime = BSPF::stoi(arg.substr(splitPoint+1, string::npos));
-      run.runtime = runtime > 0 ? runtime : RUNTIME_DEFAULT;
-    }
+  if (myNumThreads == 0)
+    myNumThreads = std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ProfilingRunner::addRun(const string& arg)
+{
+  const size_t splitPoint = arg.find_first_of(':');
+  const string romFile = splitPoint == string::npos ? arg : arg.substr(0, splitPoint);
+
+  uInt32 runtime = RUNTIME_DEFAULT;
+  if (splitPoint != string::npos) {
+    const int value = BSPF::stoi(arg.substr(splitPoint+1, string::npos));
+    if (value > 0) runtime = value;
   }
 
-  mySettings.setValue("fastscbios", true);
+  // In benchmark mode, directories are expanded into all ROMs they contain
+  vector<string> romFiles;
+  if (myBenchmark) collectRoms(FSNode(romFile), romFiles);
+  else             romFiles.push_back(romFile);
+
+  for (const string& file : romFiles)
+    profilingRuns.push_back({file, runtime});
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ProfilingRunner::run()
+{
+  return myBenchmark ? runBenchmark() : runProfile();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::runProfile()
 {
   cout << "Profiling Stella..." << endl;
 
   for (const ProfilingRun& run : profilingRuns) {
     cout << endl << "running " << run.romFile << " for " << run.runtime << " seconds..." << endl;
 
-    if (!runOne(run)) return false;
+    ProfilingResult result;
+    if (!runOne(run, result)) {
+      cout << "ERROR: " << result.error << endl;
+      return false;
+    }
+
+    (cout << "100%" << endl).flush();
+    cout << "real time: " << result.realtimeUsed << " seconds" << endl;
   }
 
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ProfilingRunner::runBenchmark()
+{
+  vector<ProfilingResult> results(profilingRuns.size());
+  std::atomic<size_t> nextRun{0};
+
+  // Each worker pulls the next pending job until all are done; every job
+  // writes to its own result slot, so no further synchronization is needed
+  const auto worker = [&]() {
+    for (size_t i = nextRun++; i < profilingRuns.size(); i = nextRun++) {
+      try {
+        runOne(profilingRuns[i], results[i]);
+      }
+      catch (const std::exception& e) {
+        results[i].ok = false;
+        results[i].error = e.what();
+      }
+    }
+  };
+
+  // Keep stdout clean for the JSON report
+  Logger::instance().setLogParameters(Logger::Level::MIN, false);
+  Logger::instance().setErrorStream(cerr);
+
+  const uInt32 numThreads = static_cast<uInt32>(
+    std::min<size_t>(myNumThreads, std::max<size_t>(profilingRuns.size(), 1)));
+
+  cerr << "Benchmarking " << profilingRuns.size() << " ROM(s) on "
+       << numThreads << " thread(s)..." << endl;
+
+  const time_point<high_resolution_clock> tp = high_resolution_clock::now();
+
+  vector<std::thread> threads;
+  threads.reserve(numThreads);
+  for (uInt32 i = 0; i < numThreads; ++i) threads.emplace_back(worker);
+  for (auto& thread : threads) thread.join();
+
+  const double wallTime = duration_cast<duration<double>>(high_resolution_clock::now() - tp).count();
+
+  bool ok = true;
+  uInt64 totalCycles = 0;
+  json jResults = json::array();
+
+  for (size_t i = 0; i < profilingRuns.size(); ++i) {
+    const ProfilingRun& run = profilingRuns[i];
+    const ProfilingResult& result = results[i];
+    json jResult = {
+      { "rom", run.romFile },
+      { "runtime", run.runtime },
+      { "status", result.ok ? "ok" : "error" }
+    };
+
+    if (result.ok) {
+      const double realtime = std::max(result.realtimeUsed, 1e-9);
+
+      jResult["layout"] = result.layout;
+      jResult["cycles"] = result.cycles;
+      jResult["frames"] = result.frames;
+      jResult["realTime"] = result.realtimeUsed;
+      jResult["cyclesPerSecond"] = result.cycles / realtime;
+      jResult["framesPerSecond"] = result.frames / realtime;
+      jResult["speed"] = result.cycles / result.cyclesPerSecond / realtime;
+
+      totalCycles += result.cycles;
+    }
+    else {
+      jResult["error"] = result.error;
+      ok = false;
+    }
+
+    jResults.push_back(jResult);
+  }
+
+  const json jBenchmark = {
+    { "threads", numThreads },
+    { "wallTime", wallTime },
+    { "cyclesPerSecond", totalCycles / std::max(wallTime, 1e-9) },
+    { "results", jResults }
+  };
+
+  if (myOutFile.empty())
+    cout << jBenchmark.dump(2) << endl;
+  else {
+    std::ofstream out(myOutFile);
+    if (!out) {
+      cerr << "ERROR: unable to write " << myOutFile << endl;
+      return false;
+    }
+    out << jBenchmark.dump(2) << endl;
+  }
+
+  return ok;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // FIXME
 // Warning	C6262	Function uses '301164' bytes of stack : exceeds / analyze :
 //                stacksize '16384'.  Consider moving some data to heap.
-bool ProfilingRunner::runOne(const ProfilingRun& run)
+bool ProfilingRunner::runOne(const ProfilingRun& run, ProfilingResult& result) const
 {
+  // Console progress is only shown when profiling sequentially
+  const bool verbose = !myBenchmark;
+
   const FSNode imageFile(run.romFile);
 
   if (!imageFile.isFile()) {
-    cout << "ERROR: " << run.romFile << " is not a ROM image" << endl;
+    result.error = run.romFile + " is not a ROM image";
     return false;
   }
 
   ByteBuffer image;
   const size_t size = imageFile.read(image);
   if (size == 0) {
-    cout << "ERROR: unable to read " << run.romFile << endl;
+    result.error = "unable to read " + run.romFile;
     return false;
   }
 
+  // Every run uses its own settings, since cartridge creation modifies them
+  Settings settings;
+  settings.setValue("fastscbios", true);
+  const Properties props;
+
   string md5 = MD5::hash(image, size);
   const string type;
   unique_ptr<Cartridge> cartridge = CartCreator::create(
-      imageFile, image, size, md5, type, mySettings);
+      imageFile, image, size, md5, type, settings);
 
   if (!cartridge) {
-    cout << "ERROR: unable to determine cartridge type" << endl;
+    result.error = "unable to determine cartridge type";
     return false;
   }
 
@@ -123,14 +278,14 @@ bool ProfilingRunner::runOne(const ProfilingRun& run)
   Random rng(0);
   const Event event;
 
-  M6502 cpu(mySettings);
-  M6532 riot(consoleIO, mySettings);
-  TIA tia(consoleIO, []() { return ConsoleTiming::ntsc; }, mySettings);
+  M6502 cpu(settings);
+  M6532 riot(consoleIO, settings);
+  TIA tia(consoleIO, []() { return ConsoleTiming::ntsc; }, settings);
   System system(rng, cpu, riot, tia, *cartridge);
 
   consoleIO.myLeftControl = make_unique<Joystick>(Controller::Jack::Left, event, system);
   consoleIO.myRightControl = make_unique<Joystick>(Controller::Jack::Right, event, system);
-  consoleIO.mySwitches = make_unique<Switches>(event, myProps, mySettings);
+  consoleIO.mySwitches = make_unique<Switches>(event, props, settings);
 
   tia.bindToControllers();
   cartridge->setStartBankFromPropsFunc([]() { return -1; });
@@ -140,7 +295,7 @@ bool ProfilingRunner::runOne(const ProfilingRun& run)
   tia.setFrameManager(&frameLayoutDetector);
   system.reset();
 
-  (cout << "detecting frame layout... ").flush();
+  if (verbose) (cout << "detecting frame layout... ").flush();
   for(int i = 0; i < 60; ++i) tia.update();
 
   const FrameLayout frameLayout = frameLayoutDetector.detectedLayout();
@@ -148,12 +303,12 @@ bool ProfilingRunner::runOne(const ProfilingRun& run)
 
   switch (frameLayout) {
     case FrameLayout::ntsc:
-      cout << "NTSC";
+      result.layout = "NTSC";
       consoleTiming = ConsoleTiming::ntsc;
       break;
 
     case FrameLayout::pal:
-      cout << "PAL";
+      result.layout = "PAL";
       consoleTiming = ConsoleTiming::pal;
       break;
 
@@ -161,7 +316,7 @@ bool ProfilingRunner::runOne(const ProfilingRun& run)
       break;
   }
 
-  (cout << endl).flush();
+  if (verbose) (cout << result.layout << endl).flush();
 
   FrameManager frameManager;
   tia.setFrameManager(&frameManager);
@@ -171,13 +326,14 @@ bool ProfilingRunner::runOne(const ProfilingRun& run)
 
   const EmulationTiming emulationTiming(frameLayout, consoleTiming);
   uInt64 cycles = 0;
+  uInt64 frames = 0;
   const uInt64 cyclesTarget = static_cast<uInt64>(run.runtime) * emulationTiming.cyclesPerSecond();
 
   DispatchResult dispatchResult;
   dispatchResult.setOk(0);
 
   uInt32 percent = 0;
-  (cout << "0%").flush();
+  if (verbose) (cout << "0%").flush();
 
   const time_point<high_resolution_clock> tp = high_resolution_clock::now();
 
@@ -185,24 +341,31 @@ bool ProfilingRunner::runOne(const ProfilingRun& run)
     tia.update(dispatchResult);
     cycles += dispatchResult.getCycles();
 
-    if (tia.newFramePending()) tia.renderToFrameBuffer();
+    if (tia.newFramePending()) {
+      tia.renderToFrameBuffer();
+      ++frames;
+    }
 
-    const uInt32 percentNow = static_cast<uInt32>(std::min((100 * cycles) /
-      cyclesTarget, static_cast<uInt64>(100)));
-    updateProgress(percent, percentNow);
+    if (verbose) {
+      const uInt32 percentNow = static_cast<uInt32>(std::min((100 * cycles) /
+        cyclesTarget, static_cast<uInt64>(100)));
+      updateProgress(percent, percentNow);
 
-    percent = percentNow;
+      percent = percentNow;
+    }
   }
 
-  const double realtimeUsed = duration_cast<duration<double>>(high_resolution_clock::now () - tp).count();
+  result.realtimeUsed = duration_cast<duration<double>>(high_resolution_clock::now () - tp).count();
+  result.cycles = cycles;
+  result.frames = frames;
+  result.cyclesPerSecond = emulationTiming.cyclesPerSecond();
 
   if (dispatchResult.getStatus() != DispatchResult::Status::ok) {
-    cout << endl << "ERROR: emulation failed after " << cycles << " cycles";
+    result.error = "emulation failed after " + std::to_string(cycles) + " cycles";
+    if (verbose) cout << endl;
     return false;
   }
 
-  (cout << "100%" << endl).flush();
-  cout << "real time: " << realtimeUsed << " seconds" << endl;
-
+  result.ok = true;
   return true;
 }
@@ -25,6 +25,18 @@
 #include "ConsoleIO.hxx"
 #include "Props.hxx"
 
+/**
+  Headless runner used for profiling and benchmarking the emulation core.
+
+  In '-profile' mode, the given ROMs are run one after another, printing
+  the real time used by each run.
+
+  In '-benchmark' mode, all ROMs (directories are expanded recursively) are
+  distributed over a pool of worker threads, each job using its own
+  System/TIA/M6502.  The measured throughput of every ROM is written as JSON
+  to stdout or to the file given by '-out'.  The number of worker threads
+  defaults to the number of cores and can be overridden by '-threads'.
+*/
 class ProfilingRunner {
   public:
 
@@ -39,6 +51,16 @@ class ProfilingRunner {
       uInt32 runtime{0};
     };
 
+    struct ProfilingResult {
+      bool ok{false};
+      string error;
+      string layout;
+      uInt64 cycles{0};
+      uInt64 frames{0};
+      double cyclesPerSecond{0.}; // of the emulated console
+      double realtimeUsed{0.};
+    };
+
     struct IO: public ConsoleIO {
       Controller& leftController() const override { return *myLeftControl; }
       Controller& rightController() const override { return *myRightControl; }
@@ -51,15 +73,20 @@ class ProfilingRunner {
 
   private:
 
-    bool runOne(const ProfilingRun& run);
+    bool runProfile();
+    bool runBenchmark();
+
+    bool runOne(const ProfilingRun& run, ProfilingResult& result) const;
+
+    void addRun(const string& arg);
 
   private:
 
     vector<ProfilingRun> profilingRuns;
 
-    Settings mySettings;
-
-    Properties myProps;
+    bool myBenchmark{false};
+    uInt32 myNumThreads{0};
+    string myOutFile;
 };
 
 #endif // PROFILING_RUNNER
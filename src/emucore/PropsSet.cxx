@@ -72,35 +72,70 @@ bool PropertiesSet::getMD5(string_view md5, Properties& properties,
     }
   }
 
-  // Otherwise, search the internal database using binary search
+  // Otherwise, search the internal database
   if(!found)
   {
-    int low = 0, high = DEF_PROPS_SIZE - 1;
-    while(low <= high)
+    const int i = findDefault(md5);
+    if(i >= 0)
     {
-      const int i = (low + high) / 2;
-      const int cmp = BSPF::compareIgnoreCase(md5,
-          DefProps[i][static_cast<uInt8>(PropType::Cart_MD5)]);
-
-      if(cmp == 0)  // found it
-      {
-        for(uInt8 p = 0; p < static_cast<uInt8>(PropType::NumTypes); ++p)
-          if(DefProps[i][p][0] != 0)
-            properties.set(PropType{p}, DefProps[i][p]);
-
-        found = true;
-        break;
-      }
-      else if(cmp < 0)
-        high = i - 1; // look at lower range
-      else
-        low = i + 1;  // look at upper range
+      loadDefault(i, properties);
+      found = true;
     }
   }
 
   return found;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int PropertiesSet::findDefault(string_view md5)
+{
+  // Convert the md5 into the four 32-bit words used as key
+  if(md5.size() != 32)
+    return -1;
+
+  std::array<uInt32, 4> key{};
+  for(size_t i = 0; i < md5.size(); ++i)
+  {
+    const char c = md5[i];
+    uInt32 nibble = 0;
+    if(c >= '0' && c <= '9')
+      nibble = c - '0';
+    else if(c >= 'a' && c <= 'f')
+      nibble = c - 'a' + 10;
+    else if(c >= 'A' && c <= 'F')
+      nibble = c - 'A' + 10;
+    else
+      return -1;
+
+    key[i / 8] = (key[i / 8] << 4) | nibble;
+  }
+
+  // Word 0 selects the seed, which places words 1 and 2 in a unique slot
+  // (this must match 'hash_slot' in 'create_props.pl')
+  const uInt64 seed = DefPropsHashSeed[key[0] % DEF_PROPS_HASH_BUCKETS];
+  const uInt64 slot = (key[1] + seed * (key[2] % (DEF_PROPS_HASH_SLOTS - 1) + 1))
+                      % DEF_PROPS_HASH_SLOTS;
+  const uInt32 index = DefPropsHashSlot[slot];
+
+  // The slot may be unused, or contain a different md5
+  return index < DEF_PROPS_SIZE && DefPropsMD5[index] == key
+         ? static_cast<int>(index) : -1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PropertiesSet::loadDefault(uInt32 index, Properties& properties)
+{
+  const auto& md5 = DefPropsMD5[index];
+  std::array<char, 33> buf{};
+  std::ignore = std::snprintf(buf.data(), buf.size(), "%08x%08x%08x%08x",
+                              md5[0], md5[1], md5[2], md5[3]);
+  properties.set(PropType::Cart_MD5, buf.data());
+
+  for(uInt8 p = 0; p < static_cast<uInt8>(PropType::NumTypes); ++p)
+    if(DefProps[index][p] != 0)
+      properties.set(PropType{p}, DefPropsValues[DefProps[index][p]]);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PropertiesSet::insert(const Properties& properties, bool save)
 {
@@ -200,11 +235,9 @@ void PropertiesSet::print() const
   for(uInt32 i = 0; i < DEF_PROPS_SIZE; ++i)
   {
     properties.setDefaults();
-    for(uInt8 p = 0; p < static_cast<uInt8>(PropType::NumTypes); ++p)
-      if(DefProps[i][p][0] != 0)
-        properties.set(PropType{p}, DefProps[i][p]);
+    loadDefault(i, properties);
 
-    list.emplace(DefProps[i][static_cast<uInt8>(PropType::Cart_MD5)], properties);
+    list.emplace(properties.get(PropType::Cart_MD5), properties);
   }
 
   // Now, print the resulting list
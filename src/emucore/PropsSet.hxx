@@ -89,6 +89,25 @@ class PropertiesSet
     */
     void print() const;
 
+  private:
+    /**
+      Find the given MD5 in the built-in properties, using the perfect
+      hash generated into 'DefProps.hxx'.
+
+      @param md5  The md5 to search for (case-insensitive)
+
+      @return  The index of the built-in entry, or -1 if not found
+    */
+    static int findDefault(string_view md5);
+
+    /**
+      Fill the properties with the built-in entry at the given index.
+
+      @param index       The index as returned by 'findDefault'
+      @param properties  The properties to fill
+    */
+    static void loadDefault(uInt32 index, Properties& properties);
+
   private:
     using PropsList = std::map<string, Properties, std::less<>>;
 
@@ -69,21 +69,18 @@ Serializer::Serializer(string_view filename, Mode m)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Serializer::Serializer()
-  : myStream{make_unique<stringstream>(ios::in | ios::out | ios::binary)}
+  : myInMemory{true}
 {
-  // For some reason, Windows and possibly macOS needs to store something in
-  // the stream before it is used for the first time
-  if(myStream)
-  {
-    putBool(true);
-    rewind();
-    myStream->exceptions( ios_base::failbit | ios_base::badbit | ios_base::eofbit );
-  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::setPosition(size_t pos)
 {
+  if(myInMemory)
+  {
+    myReadPos = myWritePos = pos;
+    return;
+  }
   myStream->clear();
   myStream->seekg(pos);
   myStream->seekp(pos);
@@ -92,14 +89,24 @@ void Serializer::setPosition(size_t pos)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::rewind()
 {
-  myStream->clear();
-  myStream->seekg(ios_base::beg);
-  myStream->seekp(ios_base::beg);
+  setPosition(0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Serializer::reset()
+{
+  if(myInMemory)
+    myBuffer.clear();
+
+  setPosition(0);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 size_t Serializer::size()
 {
+  if(myInMemory)
+    return myBuffer.size();
+
   const std::streampos oldPos = myStream->tellp();
 
   myStream->seekp(0, std::ios::end);
@@ -109,26 +116,63 @@ size_t Serializer::size()
   return s;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Serializer::read(void* data, size_t size) const
+{
+  if(!myInMemory)
+  {
+    myStream->read(static_cast<char*>(data), size);
+    return;
+  }
+  if(size > myBuffer.size() || myReadPos > myBuffer.size() - size)
+    throw runtime_error("Serializer: read beyond end of data");
+
+  if(size > 0)
+    std::copy_n(myBuffer.data() + myReadPos, size, static_cast<uInt8*>(data));
+  myReadPos += size;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Serializer::write(const void* data, size_t size)
+{
+  if(!myInMemory)
+  {
+    myStream->write(static_cast<const char*>(data), size);
+    return;
+  }
+  if(myWritePos + size > myBuffer.size())
+  {
+    // Grow geometrically; the allocated memory is kept when rewinding
+    if(myWritePos + size > myBuffer.capacity())
+      myBuffer.reserve(std::max(myWritePos + size, myBuffer.capacity() * 2));
+    myBuffer.resize(myWritePos + size);
+  }
+
+  if(size > 0)
+    std::copy_n(static_cast<const uInt8*>(data), size, myBuffer.data() + myWritePos);
+  myWritePos += size;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 Serializer::getByte() const
 {
-  char buf{0};
-  myStream->read(&buf, 1);
+  uInt8 val{0};
+  read(&val, 1);
 
-  return buf;
+  return val;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::getByteArray(uInt8* array, size_t size) const
 {
-  myStream->read(reinterpret_cast<char*>(array), size);
+  read(array, size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt16 Serializer::getShort() const
 {
   uInt16 val{0};
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(uInt16));
+  read(&val, sizeof(uInt16));
 
   return val;
 }
@@ -136,14 +180,14 @@ uInt16 Serializer::getShort() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::getShortArray(uInt16* array, size_t size) const
 {
-  myStream->read(reinterpret_cast<char*>(array), sizeof(uInt16)*size);
+  read(array, sizeof(uInt16)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 Serializer::getInt() const
 {
   uInt32 val{0};
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(uInt32));
+  read(&val, sizeof(uInt32));
 
   return val;
 }
@@ -151,14 +195,14 @@ uInt32 Serializer::getInt() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::getIntArray(uInt32* array, size_t size) const
 {
-  myStream->read(reinterpret_cast<char*>(array), sizeof(uInt32)*size);
+  read(array, sizeof(uInt32)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt64 Serializer::getLong() const
 {
   uInt64 val{0};
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(uInt64));
+  read(&val, sizeof(uInt64));
 
   return val;
 }
@@ -167,7 +211,7 @@ uInt64 Serializer::getLong() const
 double Serializer::getDouble() const
 {
   double val{0.0};
-  myStream->read(reinterpret_cast<char*>(&val), sizeof(double));
+  read(&val, sizeof(double));
 
   return val;
 }
@@ -175,10 +219,10 @@ double Serializer::getDouble() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string Serializer::getString() const
 {
-  const int len = getInt();
+  const uInt32 len = getInt();
   string str;
   str.resize(len);
-  myStream->read(str.data(), len);
+  read(str.data(), len);
 
   return str;
 }
@@ -192,56 +236,56 @@ bool Serializer::getBool() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putByte(uInt8 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), 1);
+  write(&value, 1);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putByteArray(const uInt8* array, size_t size)
 {
-  myStream->write(reinterpret_cast<const char*>(array), size);
+  write(array, size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putShort(uInt16 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(uInt16));
+  write(&value, sizeof(uInt16));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putShortArray(const uInt16* array, size_t size)
 {
-  myStream->write(reinterpret_cast<const char*>(array), sizeof(uInt16)*size);
+  write(array, sizeof(uInt16)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putInt(uInt32 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(uInt32));
+  write(&value, sizeof(uInt32));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putIntArray(const uInt32* array, size_t size)
 {
-  myStream->write(reinterpret_cast<const char*>(array), sizeof(uInt32)*size);
+  write(array, sizeof(uInt32)*size);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putLong(uInt64 value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(uInt64));
+  write(&value, sizeof(uInt64));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putDouble(double value)
 {
-  myStream->write(reinterpret_cast<char*>(&value), sizeof(double));
+  write(&value, sizeof(double));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::putString(string_view str)
 {
   putInt(static_cast<uInt32>(str.size()));
-  myStream->write(str.data(), str.size());
+  write(str.data(), str.size());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
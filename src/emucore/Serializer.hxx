@@ -30,6 +30,12 @@
   strings are written as characters prepended by the length of the string,
   boolean values are written using a special character pattern.
 
+  In-memory serializers use a contiguous, growable byte buffer instead of
+  a stream. Like a stream, the buffer has separate read and write positions,
+  and reading beyond the end of the data throws an exception. Rewinding
+  keeps the allocated memory, so a serializer can be reused without further
+  allocations.
+
   @author  Stephen Anthony
 */
 class Serializer
@@ -57,7 +63,7 @@ class Serializer
       Answers whether the serializer is currently initialized for reading
       and writing.
     */
-    explicit operator bool() const { return myStream != nullptr; }
+    explicit operator bool() const { return myStream != nullptr || myInMemory; }
 
     /**
       Sets the read/write location to the given offset in the stream.
@@ -69,11 +75,25 @@ class Serializer
     */
     void rewind();
 
+    /**
+      Discards all data of an in-memory serializer and resets the read/write
+      location, while keeping the allocated memory for reuse.  For file based
+      serializers, this is the same as rewind().
+    */
+    void reset();
+
     /**
       Returns the current total size of the stream.
     */
     size_t size();
 
+    /**
+      Returns the data of an in-memory serializer without copying it (or
+      nullptr for file based serializers). The pointer is only valid until
+      the next write.
+    */
+    const uInt8* data() const { return myInMemory ? myBuffer.data() : nullptr; }
+
     /**
       Reads a byte value (unsigned 8-bit) from the current input stream.
 
@@ -221,9 +241,22 @@ class Serializer
     void putBool(bool b);
 
   private:
-    // The stream to send the serialized data to.
+    /**
+      Reads/writes raw bytes from/to the stream or buffer.
+    */
+    void read(void* data, size_t size) const;
+    void write(const void* data, size_t size);
+
+  private:
+    // The stream to send the serialized data to (file based serializers)
     unique_ptr<iostream> myStream;
 
+    // The buffer holding the data of in-memory serializers
+    ByteArray myBuffer;
+    mutable size_t myReadPos{0};
+    size_t myWritePos{0};
+    bool myInMemory{false};
+
     static constexpr uInt8 TruePattern = 0xfe, FalsePattern = 0x01;
 };
 
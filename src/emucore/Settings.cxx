@@ -219,6 +219,8 @@ Settings::Settings()
   setPermanent("avoxport", "");
   setPermanent("fastscbios", "true");
   setPermanent("threads", "false");
+  setPermanent("freerun", "false");
+  setPermanent("idleskip", "false");
   setTemporary("romloadcount", "0");
   setTemporary("maxres", "");
   setPermanent("initials", "");
@@ -632,6 +634,9 @@ void Settings::usage()
     << "  -fastscbios   <1|0>          Disable Supercharger BIOS progress loading bars\n"
     << "  -threads      <1|0>          Whether to using multi-threading during\n"
     << "                                emulation\n"
+    << "  -freerun      <1|0>          Keep emulating on a separate thread instead of\n"
+    << "                                starting and stopping it for each frame\n"
+    << "  -idleskip     <1|0>          Skip CPU loops which only wait for the timer\n"
     << "  -snapsavedir  <path>         The directory to save snapshot files to\n"
     << "  -snaploaddir  <path>         The directory to load snapshot files from\n"
     << "  -snapname     <int|rom>      Name snapshots according to internal database or\n"
@@ -146,16 +146,26 @@ Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt32 rom_size
     cStack{c_stack},
     decodedRom{make_unique<Op[]>(romSize / 2)},  // NOLINT
     decodedParam{make_unique<uInt32[]>(romSize / 2)},  // NOLINT
+    romBlockLen{make_unique<uInt16[]>(romSize / 2)},  // NOLINT
+  #ifndef UNSAFE_OPTIMIZATIONS
+    decodedRam{make_unique<Op[]>(RAMSIZE / 2)},  // NOLINT
+    decodedRamParam{make_unique<uInt32[]>(RAMSIZE / 2)},  // NOLINT
+    ramBlockLen{make_unique<uInt16[]>(RAMSIZE / 2)},  // NOLINT
+  #endif
     ram{ram_ptr},
     configuration{configurefor},
     myCartridge{cartridge}
 {
   for(uInt32 i = 0; i < romSize / 2; ++i)
-    decodedRom[i] = decodeInstructionWord(CONV_RAMROM(rom[i]), i * 2);
+    decodedRom[i] = decodeInstructionWord(CONV_RAMROM(rom[i]), i * 2, decodedParam[i]);
+#ifndef UNSAFE_OPTIMIZATIONS
+  clearRamCode();
+#endif
 
   setConsoleTiming(ConsoleTiming::ntsc);
 #ifndef UNSAFE_OPTIMIZATIONS
   trapFatalErrors(traponfatal);
+  mapMemoryPages();
 #endif
 #ifdef DEBUGGER_SUPPORT
   cycleFactor(cyclefactor);
@@ -168,14 +178,21 @@ string Thumbulator::doRun(uInt32& cycles, bool irqDrivenAudio)
 {
   _irqDrivenAudio = irqDrivenAudio;
   reset();
-  for(;;)
-  {
-    if(execute()) break;
 #ifndef UNSAFE_OPTIMIZATIONS
-    if(_stats.instructions > 500000) // way more than would otherwise be possible
-      throw runtime_error("instructions > 500000");
+  // RAM may have been modified from outside since the last run
+  if(_ramCodeDecoded)
+    clearRamCode();
 #endif
+#ifdef DEBUGGER_SUPPORT
+  if(_profiler.isEnabled())
+  {
+    _profiler.beginRun(cStart);
+    execute();
+    _profiler.endRun(profilerClock());
   }
+  else
+#endif
+  execute();
 #ifdef THUMB_CYCLE_COUNT
   _totalCycles *= _armCyclesFactor;
 
@@ -298,12 +315,9 @@ void Thumbulator::dump_regs()
 #endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-FORCE_INLINE uInt32 Thumbulator::fetch16(uInt32 addr)
-{
-#ifndef UNSAFE_OPTIMIZATIONS
-  uInt32 data = 0;
-
 #ifdef THUMB_CYCLE_COUNT
+FORCE_INLINE void Thumbulator::fetchCycles(uInt32 addr)
+{
   _pipeIdx = (_pipeIdx+1) % 3;
 
 #ifdef MERGE_I_S
@@ -333,6 +347,17 @@ FORCE_INLINE uInt32 Thumbulator::fetch16(uInt32 addr)
   }
   _prefetchCycleType[_pipeIdx] = CycleType::S; // default
   //_prefetchAccessType[_pipeIdx] = AccessType::prefetch; // default
+}
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FORCE_INLINE uInt32 Thumbulator::fetch16(uInt32 addr)
+{
+#ifndef UNSAFE_OPTIMIZATIONS
+  uInt32 data = 0;
+
+#ifdef THUMB_CYCLE_COUNT
+  fetchCycles(addr);
 #endif
 
   switch(addr & 0xF0000000)
@@ -364,6 +389,28 @@ FORCE_INLINE uInt32 Thumbulator::fetch16(uInt32 addr)
 #endif
 }
 
+#ifndef UNSAFE_OPTIMIZATIONS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FORCE_INLINE void Thumbulator::invalidateRamCode(uInt32 idx)
+{
+  if(decodedRam[idx] != Op::numOps)
+  {
+    // self-modifying code, the blocks containing the halfword must be relinked
+    decodedRam[idx] = Op::numOps;
+    _ramBlocksValid = false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::clearRamCode()
+{
+  std::fill_n(decodedRam.get(), RAMSIZE / 2, Op::numOps);
+  std::fill_n(ramBlockLen.get(), RAMSIZE / 2, 0);
+  _ramCodeDecoded = false;
+  _ramBlocksValid = true;
+}
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Thumbulator::write16(uInt32 addr, uInt32 data)
 {
@@ -374,6 +421,16 @@ void Thumbulator::write16(uInt32 addr, uInt32 data)
   THUMB_STAT(_stats.writes)
   DO_DBUG(statusMsg << "write16(" << Base::HEX8 << addr << "," << Base::HEX8 << data << ")" << endl);
 
+#ifndef UNSAFE_OPTIMIZATIONS
+  const MemoryPage& page = memoryPage(addr);
+  if(page.write)
+  {
+    page.write[(addr & PAGE_MASK) >> 1] = CONV_DATA(data);
+    invalidateRamCode((addr & RAMADDMASK) >> 1);
+    return;
+  }
+#endif
+
   switch(addr & 0xF0000000)
   {
     case 0x40000000: //RAM
@@ -386,6 +443,9 @@ void Thumbulator::write16(uInt32 addr, uInt32 data)
       addr &= RAMADDMASK;
       addr >>= 1;
       ram[addr] = CONV_DATA(data);
+#ifndef UNSAFE_OPTIMIZATIONS
+      invalidateRamCode(addr);
+#endif
       return;
 
 #ifndef UNSAFE_OPTIMIZATIONS
@@ -415,6 +475,22 @@ void Thumbulator::write32(uInt32 addr, uInt32 data)
 #endif
   DO_DBUG(statusMsg << "write32(" << Base::HEX8 << addr << "," << Base::HEX8 << data << ")" << endl);
 
+#ifndef UNSAFE_OPTIMIZATIONS
+  const MemoryPage& page = memoryPage(addr);
+  if(page.write)
+  {
+  #ifdef THUMB_STATS
+    _stats.writes += 2;
+  #endif
+    uInt16* ptr = page.write + ((addr & PAGE_MASK) >> 1);
+    ptr[0] = CONV_DATA(data);
+    ptr[1] = CONV_DATA(data >> 16);
+    invalidateRamCode((addr & RAMADDMASK) >> 1);
+    invalidateRamCode(((addr & RAMADDMASK) >> 1) + 1);
+    return;
+  }
+#endif
+
   switch(addr & 0xF0000000)
   {
 #ifndef UNSAFE_OPTIMIZATIONS
@@ -616,6 +692,47 @@ FORCE_INLINE bool Thumbulator::isProtectedRAM(uInt32 addr)
 
   return false;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::mapMemoryPages()
+{
+  // Only pages which are completely valid (and for writing, not protected)
+  // get mapped. All other accesses take the checked path.
+  for(uInt32 i = 0; i < REGION_PAGES; ++i)
+  {
+    const uInt32 first = i << PAGE_BITS, last = first | PAGE_MASK;
+    MemoryPage& romPage = pageTable[i];
+    MemoryPage& ramPage = pageTable[REGION_PAGES + i];
+
+    romPage = ramPage = MemoryPage{};
+    if(!isInvalidROM(first) && !isInvalidROM(last))
+      romPage.read = rom + (first >> 1);
+
+    if(!isInvalidRAM(0x40000000 | first) && !isInvalidRAM(0x40000000 | last))
+    {
+      bool isProtected = false;
+
+      for(uInt32 addr = first; addr < last && !isProtected; addr += 2)
+        isProtected = isProtectedRAM(0x40000000 | addr);
+
+      ramPage.read = ram + (first >> 1);
+      if(!isProtected)
+        ramPage.write = ram + (first >> 1);
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FORCE_INLINE const Thumbulator::MemoryPage& Thumbulator::memoryPage(uInt32 addr) const
+{
+  static constexpr MemoryPage unmapped{};
+
+  // Only the first 512 KB of ROM (0x0xxxxxxx) and RAM (0x4xxxxxxx) are paged
+  if(addr & ~(0x40000000 | ROMADDMASK))
+    return unmapped;
+
+  return pageTable[(addr >> 30) * REGION_PAGES + ((addr & ROMADDMASK) >> PAGE_BITS)];
+}
 #endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -628,6 +745,16 @@ uInt32 Thumbulator::read16(uInt32 addr)
 #endif
   THUMB_STAT(_stats.reads)
 
+#ifndef UNSAFE_OPTIMIZATIONS
+  const MemoryPage& page = memoryPage(addr);
+  if(page.read)
+  {
+    data = CONV_RAMROM(page.read[(addr & PAGE_MASK) >> 1]);
+    DO_DBUG(statusMsg << "read16(" << Base::HEX8 << addr << ")=" << Base::HEX4 << data << endl);
+    return data;
+  }
+#endif
+
   switch(addr & 0xF0000000)
   {
     case 0x00000000: //ROM
@@ -678,6 +805,20 @@ uInt32 Thumbulator::read32(uInt32 addr)
 #endif
 
   uInt32 data = 0;
+#ifndef UNSAFE_OPTIMIZATIONS
+  const MemoryPage& page = memoryPage(addr);
+  if(page.read)
+  {
+  #ifdef THUMB_STATS
+    _stats.reads += 2;
+  #endif
+    const uInt16* ptr = page.read + ((addr & PAGE_MASK) >> 1);
+    data = CONV_RAMROM(ptr[0]) | (CONV_RAMROM(ptr[1]) << 16);
+    DO_DBUG(statusMsg << "read32(" << Base::HEX8 << addr << ")=" << Base::HEX8 << data << endl);
+    return data;
+  }
+#endif
+
   switch(addr & 0xF0000000)
   {
     case 0x00000000: //ROM
@@ -838,7 +979,7 @@ void Thumbulator::do_cvflag(uInt32 a, uInt32 b, uInt32 c)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst, uInt32 pc) {
+Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst, uInt32 pc, uInt32& param) {
   //ADC add with carry
   if((inst & 0xFFC0) == 0x4140) return Op::adc;
 
@@ -883,7 +1024,7 @@ Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst, uInt32 pc) {
     rb <<= 1;
     rb += pc;
     rb += 2;
-    decodedParam[pc / 2] = rb + 4;
+    param = rb + 4;
 
     switch(op)
     {
@@ -944,7 +1085,7 @@ Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst, uInt32 pc) {
     rb <<= 1;
     rb += pc;
     rb += 2;
-    decodedParam[pc / 2] = rb + 4;
+    param = rb + 4;
 
     return Op::b2;
   }
@@ -1139,48 +1280,243 @@ Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst, uInt32 pc) {
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
+uInt32 Thumbulator::linkBlock(const uInt16* code, Op* ops, uInt32* params,
+                              uInt16* blockLen, uInt32 idx, uInt32 size,
+                              uInt32 base, bool isRam)
 {
-  uInt32 sp, inst, ra, rb, rc, rm, rd, rn, rs;  // NOLINT
+  uInt32 len = 0;
+  bool isEnd = false;
 
-#ifndef UNSAFE_OPTIMIZATIONS
-  uInt32 pc = read_register(15);
-#else
-  uInt32 pc = read_register(15) & ~1; // not checked and corrected in read_register
-#endif
+  for(uInt32 i = idx; i < size && len < 0xFFFF && !isEnd; ++i, ++len)
+  {
+    const uInt16 inst = CONV_RAMROM(code[i]);
 
-  const uInt32 instructionPtr = pc - 2;
-  const uInt32 instructionPtr2 = instructionPtr >> 1;
-  inst = fetch16(instructionPtr);
+  #ifndef UNSAFE_OPTIMIZATIONS
+    if(ops[i] == Op::numOps)
+    {
+      ops[i] = decodeInstructionWord(inst, base + i * 2, params[i]);
+      _ramCodeDecoded = true;
+    }
+  #endif
+    switch(ops[i])
+    {
+      case Op::beq: case Op::bne: case Op::bcs: case Op::bcc: case Op::bmi:
+      case Op::bpl: case Op::bvs: case Op::bvc: case Op::bhi: case Op::bls:
+      case Op::bge: case Op::blt: case Op::bgt: case Op::ble: case Op::b2:
+      case Op::blx_thumb: case Op::blx_arm: case Op::blx2: case Op::bx:
+      case Op::bkpt: case Op::cps: case Op::setend: case Op::swi:
+      case Op::invalid:
+        isEnd = true;
+        break;
 
-  pc += 2;
-#ifndef UNSAFE_OPTIMIZATIONS
-  write_register(15, pc, false);
+      case Op::pop:  // pop {..., pc}
+        isEnd = inst & 0x100;
+        break;
+
+      case Op::add4: case Op::cpy: case Op::mov3:  // high register, rd == pc
+        isEnd = ((inst & 0x7) | ((inst >> 4) & 0x8)) == 15;
+        break;
+
+      case Op::push: case Op::stmia:
+      case Op::str1: case Op::str2: case Op::str3:
+      case Op::strb1: case Op::strb2: case Op::strh1: case Op::strh2:
+        // the next instructions may get overwritten
+        isEnd = isRam;
+        break;
+
+      default:
+        break;
+    }
+  }
+  blockLen[idx] = len;
+
+  return len;
+}
+
+// The instructions are executed block by block. Within a block, the decoded
+// ops are dispatched one after the other, without checking the memory region
+// again. With THUMB_THREADED_DISPATCH, each op jumps directly to the next one.
+#ifdef THUMB_CYCLE_COUNT
+  #define FETCH_CYCLES  fetchCycles(instructionPtr)
 #else
-  write_register(15, pc);
+  #define FETCH_CYCLES
+#endif
+#ifdef COUNT_OPS
+  #define COUNT_OP  ++opCount[static_cast<int>(decodedOp)]
+#else
+  #define COUNT_OP
 #endif
-  DO_DISS(statusMsg << Base::HEX8 << (pc-5) << ": " << Base::HEX4 << inst << " ");
-
 #ifndef UNSAFE_OPTIMIZATIONS
-  ++_stats.instructions;
+  #define BEGIN_INSTRUCTION                 \
+    pc = instructionPtr + 4;                \
+    write_register(15, pc, false);          \
+    DO_DISS(statusMsg << Base::HEX8 << (pc-5) << ": " << Base::HEX4 << inst << " "); \
+    ++_stats.instructions;                  \
+    COUNT_OP
+#else
+  #define BEGIN_INSTRUCTION                 \
+    pc = instructionPtr + 4;                \
+    write_register(15, pc);                 \
+    COUNT_OP
+#endif
+#ifdef DEBUGGER_SUPPORT
+  #define PROFILE_BLOCK                     \
+    if(_profiler.isEnabled())               \
+      _profiler.enterBlock(instructionPtr, profilerClock())
+  #define PROFILE_CALL                      \
+    if(_profiler.isEnabled())               \
+      _profiler.call(read_register(14))
+#else
+  #define PROFILE_BLOCK
+  #define PROFILE_CALL
+#endif
+#define FETCH_FROM_BLOCK                    \
+  inst = CONV_RAMROM(code[idx]);            \
+  decodedOp = ops[idx];                     \
+  param = params[idx];                      \
+  FETCH_CYCLES
+#ifdef THUMB_THREADED_DISPATCH
+  #define OP_LABEL(op)  op_##op:
+  #define DISPATCH      goto *opTable[static_cast<size_t>(decodedOp)]
+#else
+  #define OP_LABEL(op)
+  #define DISPATCH      goto dispatch
+#endif
+#define NEXT_INSTRUCTION                    \
+  if(remaining)                             \
+  {                                         \
+    --remaining;                            \
+    ++idx;                                  \
+    instructionPtr += 2;                    \
+    FETCH_FROM_BLOCK;                       \
+    BEGIN_INSTRUCTION;                      \
+    DISPATCH;                               \
+  }                                         \
+  goto next_block
+
+#ifdef THUMB_THREADED_DISPATCH
+  // labels as values and computed gotos are GNU extensions
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wpedantic"
 #endif
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int Thumbulator::execute()  // NOLINT (readability-function-size)
+{
+  uInt32 sp, inst, ra, rb, rc, rm, rd, rn, rs;  // NOLINT
+  uInt32 pc, instructionPtr, param{0};
   Op decodedOp{};
+
+  // the current block
+  const uInt16* code{nullptr};
+  const Op* ops{nullptr};
+  const uInt32* params{nullptr};
+  uInt32 idx{0}, remaining{0};
+
+#ifdef THUMB_THREADED_DISPATCH
+  // must match the order of Op
+  static const void* const opTable[] = {
+    &&op_invalid, &&op_adc, &&op_add1, &&op_add2, &&op_add3, &&op_add4,
+    &&op_add5, &&op_add6, &&op_add7, &&op_and_, &&op_asr1, &&op_asr2,
+    &&op_beq, &&op_bne, &&op_bcs, &&op_bcc, &&op_bmi, &&op_bpl, &&op_bvs,
+    &&op_bvc, &&op_bhi, &&op_bls, &&op_bge, &&op_blt, &&op_bgt, &&op_ble,
+    &&op_b2, &&op_bic,
+  #ifndef UNSAFE_OPTIMIZATIONS
+    &&op_bkpt,
+  #else
+    &&op_invalid,
+  #endif
+    &&op_bl, &&op_blx_thumb, &&op_blx_arm, &&op_blx2, &&op_bx, &&op_cmn,
+    &&op_cmp1, &&op_cmp2, &&op_cmp3,
+  #ifndef UNSAFE_OPTIMIZATIONS
+    &&op_cps,
+  #else
+    &&op_invalid,
+  #endif
+    &&op_cpy, &&op_eor, &&op_ldmia, &&op_ldr1, &&op_ldr2, &&op_ldr3,
+    &&op_ldr4, &&op_ldrb1, &&op_ldrb2, &&op_ldrh1, &&op_ldrh2, &&op_ldrsb,
+    &&op_ldrsh, &&op_lsl1, &&op_lsl2, &&op_lsr1, &&op_lsr2, &&op_mov1,
+    &&op_mov2, &&op_mov3, &&op_mul, &&op_mvn, &&op_neg, &&op_orr, &&op_pop,
+    &&op_push, &&op_rev, &&op_rev16, &&op_revsh, &&op_ror, &&op_sbc,
+  #ifndef UNSAFE_OPTIMIZATIONS
+    &&op_setend,
+  #else
+    &&op_invalid,
+  #endif
+    &&op_stmia, &&op_str1, &&op_str2, &&op_str3, &&op_strb1, &&op_strb2,
+    &&op_strh1, &&op_strh2, &&op_sub1, &&op_sub2, &&op_sub3, &&op_sub4,
+    &&op_swi, &&op_sxtb, &&op_sxth, &&op_tst, &&op_uxtb, &&op_uxth,
+  };
+  static_assert(sizeof(opTable) / sizeof(opTable[0]) == static_cast<size_t>(Op::numOps),
+                "opTable must contain all ops");
+#endif
+
+next_block:
 #ifndef UNSAFE_OPTIMIZATIONS
-  if ((instructionPtr & 0xF0000000) == 0 && instructionPtr < romSize)
-    decodedOp = decodedRom[instructionPtr2];
+  if(_stats.instructions > 500000) // way more than would otherwise be possible
+    throw runtime_error("instructions > 500000");
+
+  instructionPtr = read_register(15) - 2;
+  if((instructionPtr & 0xF0000000) == 0 && instructionPtr >= 0x50
+     && instructionPtr < romSize)
+  {
+    code = rom;
+    ops = decodedRom.get();
+    params = decodedParam.get();
+    idx = instructionPtr >> 1;
+    remaining = romBlockLen[idx] ? romBlockLen[idx]
+      : linkBlock(rom, decodedRom.get(), decodedParam.get(), romBlockLen.get(),
+                  idx, romSize / 2, 0, false);
+    --remaining;
+    FETCH_FROM_BLOCK;
+  }
+  else if((instructionPtr & 0xF0000000) == 0x40000000
+          && (instructionPtr & ~0xF0000000) < RAMSIZE)
+  {
+    if(!_ramBlocksValid)
+    {
+      std::fill_n(ramBlockLen.get(), RAMSIZE / 2, 0);
+      _ramBlocksValid = true;
+    }
+    code = ram;
+    ops = decodedRam.get();
+    params = decodedRamParam.get();
+    idx = (instructionPtr & RAMADDMASK) >> 1;
+    remaining = ramBlockLen[idx] ? ramBlockLen[idx]
+      : linkBlock(ram, decodedRam.get(), decodedRamParam.get(), ramBlockLen.get(),
+                  idx, RAMSIZE / 2, 0x40000000, true);
+    --remaining;
+    FETCH_FROM_BLOCK;
+  }
   else
-    decodedOp = decodeInstructionWord(CONV_RAMROM(rom[instructionPtr2]), instructionPtr);
+  {
+    // not executable, let fetch16 report the error
+    inst = fetch16(instructionPtr);
+    decodedOp = decodeInstructionWord(inst, instructionPtr, param);
+    remaining = 0;
+  }
 #else
-  decodedOp = decodedRom[(instructionPtr & ROMADDMASK) >> 1];
-#endif
-
-#ifdef COUNT_OPS
-  ++opCount[static_cast<int>(decodedOp)];
+  instructionPtr = (read_register(15) & ~1) - 2; // not checked and corrected in read_register
+  code = rom;
+  ops = decodedRom.get();
+  params = decodedParam.get();
+  idx = (instructionPtr & ROMADDMASK) >> 1;
+  remaining = romBlockLen[idx] ? romBlockLen[idx]
+    : linkBlock(rom, decodedRom.get(), decodedParam.get(), romBlockLen.get(),
+                idx, romSize / 2, 0, false);
+  --remaining;
+  FETCH_FROM_BLOCK;
+#endif
+  PROFILE_BLOCK;
+  BEGIN_INSTRUCTION;
+#ifdef THUMB_THREADED_DISPATCH
+  DISPATCH;
+#else
+dispatch:
 #endif
-  switch (decodedOp) {
+  switch(decodedOp) {
     //ADC
-    case Op::adc: {
+    case Op::adc: OP_LABEL(adc) {
       rd = (inst >> 0) & 0x07;
       rm = (inst >> 3) & 0x07;
       DO_DISS(statusMsg << "adc r" << dec << rd << ",r" << dec << rm << endl);
@@ -1193,11 +1529,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       do_znflags(rc);
       if(cFlag) do_cvflag(ra, rb, 1);
       else      do_cvflag(ra, rb, 0);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ADD(1) small immediate two registers
-    case Op::add1: {
+    case Op::add1: OP_LABEL(add1) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rb = (inst >> 6) & 0x7;
@@ -1211,7 +1547,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
         write_register(rd, rc);
         do_znflags(rc);
         do_cvflag(ra, rb, 0);
-        return 0;
+        NEXT_INSTRUCTION;
       }
       else
       {
@@ -1221,7 +1557,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
     }
 
     //ADD(2) big immediate one register
-    case Op::add2: {
+    case Op::add2: OP_LABEL(add2) {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x7;
       DO_DISS(statusMsg << "adds r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
@@ -1230,11 +1566,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       do_cvflag(ra, rb, 0);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ADD(3) three registers
-    case Op::add3: {
+    case Op::add3: OP_LABEL(add3) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -1245,11 +1581,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       do_cvflag(ra, rb, 0);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ADD(4) two registers one or both high no flags
-    case Op::add4: {
+    case Op::add4: OP_LABEL(add4) {
       if((inst >> 6) & 3)
       {
         //UNPREDICTABLE
@@ -1272,11 +1608,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       }
       //fprintf(stderr,"0x%08X = 0x%08X + 0x%08X\n",rc,ra,rb);
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ADD(5) rd = pc plus immediate
-    case Op::add5: {
+    case Op::add5: OP_LABEL(add5) {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x7;
       rb <<= 2;
@@ -1284,11 +1620,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       ra = read_register(15);
       rc = (ra & (~3U)) + rb;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ADD(6) rd = sp plus immediate
-    case Op::add6: {
+    case Op::add6: OP_LABEL(add6) {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x7;
       rb <<= 2;
@@ -1296,22 +1632,22 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       ra = read_register(13);
       rc = ra + rb;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ADD(7) sp plus immediate
-    case Op::add7: {
+    case Op::add7: OP_LABEL(add7) {
       rb = (inst >> 0) & 0x7F;
       rb <<= 2;
       DO_DISS(statusMsg << "add SP,#0x" << Base::HEX2 << rb << endl);
       ra = read_register(13);
       rc = ra + rb;
       write_register(13, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //AND
-    case Op::and_: {
+    case Op::and_: OP_LABEL(and_) {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "ands r" << dec << rd << ",r" << dec << rm << endl);
@@ -1320,11 +1656,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = ra & rb;
       write_register(rd, rc);
       do_znflags(rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ASR(1) two register immediate
-    case Op::asr1: {
+    case Op::asr1: OP_LABEL(asr1) {
       rd = (inst >> 0) & 0x07;
       rm = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -1354,11 +1690,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       INC_SHIFT_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ASR(2) two register
-    case Op::asr2: {
+    case Op::asr2: OP_LABEL(asr2) {
       rd = (inst >> 0) & 0x07;
       rs = (inst >> 3) & 0x07;
       DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rs << endl);
@@ -1394,125 +1730,125 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       INC_SHIFT_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //B(1) conditional branch variants:
     // (beq, bne, bcs, bcc, bmi, bpl, bvs, bvc, bhi, bls, bge, blt, bgt, ble)
-    case Op::beq: {
+    case Op::beq: OP_LABEL(beq) {
       THUMB_STAT(_stats.branches)
       if(!znFlags)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bne: {
+    case Op::bne: OP_LABEL(bne) {
       THUMB_STAT(_stats.branches)
       if(znFlags)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bcs: {
+    case Op::bcs: OP_LABEL(bcs) {
       THUMB_STAT(_stats.branches)
       if(cFlag)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bcc: {
+    case Op::bcc: OP_LABEL(bcc) {
       THUMB_STAT(_stats.branches)
       if(!cFlag)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bmi: {
+    case Op::bmi: OP_LABEL(bmi) {
       THUMB_STAT(_stats.branches)
       if(znFlags & 0x80000000)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bpl: {
+    case Op::bpl: OP_LABEL(bpl) {
       THUMB_STAT(_stats.branches)
       if(!(znFlags & 0x80000000))
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bvs: {
+    case Op::bvs: OP_LABEL(bvs) {
       THUMB_STAT(_stats.branches)
       if(vFlag)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bvc: {
+    case Op::bvc: OP_LABEL(bvc) {
       THUMB_STAT(_stats.branches)
       if(!vFlag)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bhi: {
+    case Op::bhi: OP_LABEL(bhi) {
       THUMB_STAT(_stats.branches)
       if(cFlag && znFlags)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bls: {
+    case Op::bls: OP_LABEL(bls) {
       THUMB_STAT(_stats.branches)
       if(!znFlags || !cFlag)
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bge: {
+    case Op::bge: OP_LABEL(bge) {
       THUMB_STAT(_stats.branches)
       if(((znFlags & 0x80000000) && vFlag) ||
          ((!(znFlags & 0x80000000)) && !vFlag))
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::blt: {
+    case Op::blt: OP_LABEL(blt) {
       THUMB_STAT(_stats.branches)
       if((!(znFlags & 0x80000000) && vFlag) ||
          (((znFlags & 0x80000000)) && !vFlag))
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, param);
+      NEXT_INSTRUCTION;
     }
 
-    case Op::bgt: {
+    case Op::bgt: OP_LABEL(bgt) {
       THUMB_STAT(_stats.branches)
       if(znFlags)
       {
         if(((znFlags & 0x80000000) && vFlag) ||
            ((!(znFlags & 0x80000000)) && !vFlag))
-          write_register(15, decodedParam[instructionPtr2]);      }
-      return 0;
+          write_register(15, param);      }
+      NEXT_INSTRUCTION;
     }
 
-    case Op::ble: {
+    case Op::ble: OP_LABEL(ble) {
       THUMB_STAT(_stats.branches)
       if(!znFlags ||
          (!(znFlags & 0x80000000) && vFlag) ||
          (((znFlags & 0x80000000)) && !vFlag))
-        write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+        write_register(15, param);
+      NEXT_INSTRUCTION;
     }
 
     //B(2) unconditional branch
-    case Op::b2: {
+    case Op::b2: OP_LABEL(b2) {
       THUMB_STAT(_stats.branches)
-      write_register(15, decodedParam[instructionPtr2]);
-      return 0;
+      write_register(15, param);
+      NEXT_INSTRUCTION;
     }
 
     //BIC
-    case Op::bic: {
+    case Op::bic: OP_LABEL(bic) {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "bics r" << dec << rd << ",r" << dec << rm << endl);
@@ -1521,12 +1857,12 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = ra & (~rb);
       write_register(rd, rc);
       do_znflags(rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
 #ifndef UNSAFE_OPTIMIZATIONS
     //BKPT
-    case Op::bkpt: {
+    case Op::bkpt: OP_LABEL(bkpt) {
       rb = (inst >> 0) & 0xFF;
       statusMsg << "bkpt 0x" << Base::HEX2 << rb << endl;
       return 1;
@@ -1535,7 +1871,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
 
     //BL/BLX(1) variants
     // (bl, blx_thumb, blx_arm)
-    case Op::bl: {
+    case Op::bl: OP_LABEL(bl) {
       // branch to label
       DO_DISS(statusMsg << endl);
       rb = inst & ((1 << 11) - 1);
@@ -1543,10 +1879,10 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rb <<= 12;
       rb += pc;
       write_register(14, rb);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
-    case Op::blx_thumb: {
+    case Op::blx_thumb: OP_LABEL(blx_thumb) {
       // branch to label, switch to thumb
       rb = read_register(14);
       rb += (inst & ((1 << 11) - 1)) << 1;
@@ -1554,10 +1890,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
       write_register(14, (pc-2) | 1);
       write_register(15, rb);
-      return 0;
+      PROFILE_CALL;
+      NEXT_INSTRUCTION;
     }
 
-    case Op::blx_arm: {
+    case Op::blx_arm: OP_LABEL(blx_arm) {
       // branch to label, switch to arm
       //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
       // fxq: this should exit the code without having to detect it
@@ -1569,11 +1906,12 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
       write_register(14, (pc-2) | 1);
       write_register(15, rb);
-      return 0;
+      PROFILE_CALL;
+      NEXT_INSTRUCTION;
     }
 
     //BLX(2)
-    case Op::blx2: {
+    case Op::blx2: OP_LABEL(blx2) {
       rm = (inst >> 3) & 0xF;
       DO_DISS(statusMsg << "blx r" << dec << rm << endl);
       rc = read_register(rm);
@@ -1586,7 +1924,8 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
         rc &= ~1; // not checked and corrected in write_register
 #endif
         write_register(15, rc);
-        return 0;
+        PROFILE_CALL;
+        NEXT_INSTRUCTION;
       }
       else
       {
@@ -1597,7 +1936,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
     }
 
     //BX
-    case Op::bx: {
+    case Op::bx: OP_LABEL(bx) {
       rm = (inst >> 3) & 0xF;
       DO_DISS(statusMsg << "bx r" << dec << rm << endl);
       rc = read_register(rm);
@@ -1608,7 +1947,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
         // branch to odd address denotes 16 bit ARM code
         rc &= ~1;
         write_register(15, rc);
-        return 0;
+        NEXT_INSTRUCTION;
       }
       else
       {
@@ -1836,14 +2175,14 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
           //rc &= ~1;
           write_register(15, rc);
           //_totalCycles += 100; // just a wild guess
-          return 0;
+          NEXT_INSTRUCTION;
         }
         return 1;
       }
     }
 
     //CMN
-    case Op::cmn: {
+    case Op::cmn: OP_LABEL(cmn) {
       rn = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "cmns r" << dec << rn << ",r" << dec << rm << endl);
@@ -1852,11 +2191,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = ra + rb;
       do_znflags(rc);
       do_cvflag(ra, rb, 0);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //CMP(1) compare immediate
-    case Op::cmp1: {
+    case Op::cmp1: OP_LABEL(cmp1) {
       rb = (inst >> 0) & 0xFF;
       rn = (inst >> 8) & 0x07;
       DO_DISS(statusMsg << "cmp r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
@@ -1865,11 +2204,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
       do_znflags(rc);
       do_cvflag(ra, ~rb, 1);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //CMP(2) compare register
-    case Op::cmp2: {
+    case Op::cmp2: OP_LABEL(cmp2) {
       rn = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
@@ -1879,11 +2218,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
       do_znflags(rc);
       do_cvflag(ra, ~rb, 1);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //CMP(3) compare high register
-    case Op::cmp3: {
+    case Op::cmp3: OP_LABEL(cmp3) {
       if(((inst >> 6) & 3) == 0x0)
       {
         //UNPREDICTABLE
@@ -1901,19 +2240,19 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = ra - rb;
       do_znflags(rc);
       do_cvflag(ra, ~rb, 1);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
 #ifndef UNSAFE_OPTIMIZATIONS
     //CPS
-    case Op::cps: {
+    case Op::cps: OP_LABEL(cps) {
       DO_DISS(statusMsg << "cps TODO" << endl);
       return 1;
     }
 #endif
 
     //CPY copy high register
-    case Op::cpy: {
+    case Op::cpy: OP_LABEL(cpy) {
       //same as mov except you can use both low registers
       //going to let mov handle high registers
       rd = (inst >> 0) & 0x7;
@@ -1921,11 +2260,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       DO_DISS(statusMsg << "cpy r" << dec << rd << ",r" << dec << rm << endl);
       rc = read_register(rm);
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //EOR
-    case Op::eor: {
+    case Op::eor: OP_LABEL(eor) {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "eors r" << dec << rd << ",r" << dec << rm << endl);
@@ -1934,11 +2273,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = ra ^ rb;
       write_register(rd, rc);
       do_znflags(rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDMIA
-    case Op::ldmia: {
+    case Op::ldmia: OP_LABEL(ldmia) {
       rn = (inst >> 8) & 0x7;
     #if defined(THUMB_DISS)
       statusMsg << "ldmia r" << dec << rn << "!,{";
@@ -1977,11 +2316,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       //there is a write back exception.
       if((inst & (1 << rn)) == 0)
         write_register(rn, sp);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDR(1) two register immediate
-    case Op::ldr1: {
+    case Op::ldr1: OP_LABEL(ldr1) {
       rd = (inst >> 0) & 0x07;
       rn = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -1991,11 +2330,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read32(rb);
       write_register(rd, rc);
       INC_LDR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDR(2) three register
-    case Op::ldr2: {
+    case Op::ldr2: OP_LABEL(ldr2) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2004,11 +2343,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read32(rb);
       write_register(rd, rc);
       INC_LDR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDR(3)
-    case Op::ldr3: {
+    case Op::ldr3: OP_LABEL(ldr3) {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x07;
       rb <<= 2;
@@ -2020,11 +2359,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read32(rb);
       write_register(rd, rc);
       INC_LDR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDR(4)
-    case Op::ldr4: {
+    case Op::ldr4: OP_LABEL(ldr4) {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x07;
       rb <<= 2;
@@ -2035,11 +2374,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read32(rb);
       write_register(rd, rc);
       INC_LDR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDRB(1)
-    case Op::ldrb1: {
+    case Op::ldrb1: OP_LABEL(ldrb1) {
       rd = (inst >> 0) & 0x07;
       rn = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -2059,11 +2398,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       }
       write_register(rd, rc & 0xFF);
       INC_LDRB_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDRB(2)
-    case Op::ldrb2: {
+    case Op::ldrb2: OP_LABEL(ldrb2) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2080,11 +2419,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       }
       write_register(rd, rc & 0xFF);
       INC_LDRB_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDRH(1)
-    case Op::ldrh1: {
+    case Op::ldrh1: OP_LABEL(ldrh1) {
       rd = (inst >> 0) & 0x07;
       rn = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -2094,11 +2433,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read16(rb);
       write_register(rd, rc & 0xFFFF);
       INC_LDR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDRH(2)
-    case Op::ldrh2: {
+    case Op::ldrh2: OP_LABEL(ldrh2) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2107,11 +2446,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read16(rb);
       write_register(rd, rc & 0xFFFF);
       INC_LDR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDRSB
-    case Op::ldrsb: {
+    case Op::ldrsb: OP_LABEL(ldrsb) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2131,11 +2470,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
         rc |= ((~0U) << 8);
       write_register(rd, rc);
       INC_LDRB_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LDRSH
-    case Op::ldrsh: {
+    case Op::ldrsh: OP_LABEL(ldrsh) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2147,11 +2486,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
         rc |= ((~0U) << 16);
       write_register(rd, rc);
       INC_LDR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LSL(1)
-    case Op::lsl1: {
+    case Op::lsl1: OP_LABEL(lsl1) {
       rd = (inst >> 0) & 0x07;
       rm = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -2172,11 +2511,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       INC_SHIFT_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LSL(2) two register
-    case Op::lsl2: {
+    case Op::lsl2: OP_LABEL(lsl2) {
       rd = (inst >> 0) & 0x07;
       rs = (inst >> 3) & 0x07;
       DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rs << endl);
@@ -2204,11 +2543,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       INC_SHIFT_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LSR(1) two register immediate
-    case Op::lsr1: {
+    case Op::lsr1: OP_LABEL(lsr1) {
       rd = (inst >> 0) & 0x07;
       rm = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -2227,11 +2566,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       INC_SHIFT_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //LSR(2) two register
-    case Op::lsr2: {
+    case Op::lsr2: OP_LABEL(lsr2) {
       rd = (inst >> 0) & 0x07;
       rs = (inst >> 3) & 0x07;
       DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rs << endl);
@@ -2259,21 +2598,21 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       INC_SHIFT_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //MOV(1) immediate
-    case Op::mov1: {
+    case Op::mov1: OP_LABEL(mov1) {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x07;
       DO_DISS(statusMsg << "movs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
       write_register(rd, rb);
       do_znflags(rb);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //MOV(2) two low registers
-    case Op::mov2: {
+    case Op::mov2: OP_LABEL(mov2) {
       rd = (inst >> 0) & 7;
       rn = (inst >> 3) & 7;
       DO_DISS(statusMsg << "movs r" << dec << rd << ",r" << dec << rn << endl);
@@ -2283,11 +2622,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       do_znflags(rc);
       do_cflag_bit(0);
       do_vflag_bit(0);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //MOV(3)
-    case Op::mov3: {
+    case Op::mov3: OP_LABEL(mov3) {
       rd  = (inst >> 0) & 0x7;
       rd |= (inst >> 4) & 0x8;
       rm  = (inst >> 3) & 0xF;
@@ -2304,11 +2643,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
         rc += 2;  //The program counter is special
       }
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //MUL
-    case Op::mul: {
+    case Op::mul: OP_LABEL(mul) {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "muls r" << dec << rd << ",r" << dec << rm << endl);
@@ -2335,11 +2674,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = ra * rb;
       write_register(rd, rc);
       do_znflags(rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //MVN
-    case Op::mvn: {
+    case Op::mvn: OP_LABEL(mvn) {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "mvns r" << dec << rd << ",r" << dec << rm << endl);
@@ -2347,11 +2686,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = (~ra);
       write_register(rd, rc);
       do_znflags(rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //NEG
-    case Op::neg: {
+    case Op::neg: OP_LABEL(neg) {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "negs r" << dec << rd << ",r" << dec << rm << endl);
@@ -2360,11 +2699,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       do_cvflag(0, ~ra, 1);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ORR
-    case Op::orr: {
+    case Op::orr: OP_LABEL(orr) {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "orrs r" << dec << rd << ",r" << dec << rm << endl);
@@ -2373,11 +2712,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = ra | rb;
       write_register(rd, rc);
       do_znflags(rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //POP
-    case Op::pop: {
+    case Op::pop: OP_LABEL(pop) {
     #if defined(THUMB_DISS)
       statusMsg << "pop {";
       for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,++ra)
@@ -2433,11 +2772,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
         sp += 4;
       }
       write_register(13, sp);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //PUSH
-    case Op::push: {
+    case Op::push: OP_LABEL(push) {
     #if defined(THUMB_DISS)
       statusMsg << "push {";
       for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,++ra)
@@ -2508,11 +2847,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       }
       write_register(13, sp);
       FETCH_TYPE_N; // ??? (copied from stmia)
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //REV
-    case Op::rev: {
+    case Op::rev: OP_LABEL(rev) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "rev r" << dec << rd << ",r" << dec << rn << endl);
@@ -2522,11 +2861,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc |= ((ra >> 16) & 0xFF) <<  8;
       rc |= ((ra >> 24) & 0xFF) <<  0;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //REV16
-    case Op::rev16: {
+    case Op::rev16: OP_LABEL(rev16) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "rev16 r" << dec << rd << ",r" << dec << rn << endl);
@@ -2536,11 +2875,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc |= ((ra >> 16) & 0xFF) << 24;
       rc |= ((ra >> 24) & 0xFF) << 16;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //REVSH
-    case Op::revsh: {
+    case Op::revsh: OP_LABEL(revsh) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "revsh r" << dec << rd << ",r" << dec << rn << endl);
@@ -2550,11 +2889,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       if(rc & 0x8000) rc |= 0xFFFF0000;
       else            rc &= 0x0000FFFF;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //ROR
-    case Op::ror: {
+    case Op::ror: OP_LABEL(ror) {
       rd = (inst >> 0) & 0x7;
       rs = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "rors r" << dec << rd << ",r" << dec << rs << endl);
@@ -2582,11 +2921,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       INC_SHIFT_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //SBC
-    case Op::sbc: {
+    case Op::sbc: OP_LABEL(sbc) {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "sbc r" << dec << rd << ",r" << dec << rm << endl);
@@ -2598,19 +2937,19 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       do_znflags(rc);
       if(cFlag) do_cvflag(ra, ~rb, 1);
       else      do_cvflag(ra, ~rb, 0);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
 #ifndef UNSAFE_OPTIMIZATIONS
     //SETEND
-    case Op::setend: {
+    case Op::setend: OP_LABEL(setend) {
       statusMsg << "setend not implemented" << endl;
       return 1;
     }
 #endif
 
     //STMIA
-    case Op::stmia: {
+    case Op::stmia: OP_LABEL(stmia) {
       rn = (inst >> 8) & 0x7;
     #if defined(THUMB_DISS)
       statusMsg << "stmia r" << dec << rn << "!,{";
@@ -2647,11 +2986,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       }
       write_register(rn, sp);
       FETCH_TYPE_N;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //STR(1)
-    case Op::str1: {
+    case Op::str1: OP_LABEL(str1) {
       rd = (inst >> 0) & 0x07;
       rn = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -2661,11 +3000,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read_register(rd);
       write32(rb, rc);
       INC_STR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //STR(2)
-    case Op::str2: {
+    case Op::str2: OP_LABEL(str2) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2674,11 +3013,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read_register(rd);
       write32(rb, rc);
       INC_STR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //STR(3)
-    case Op::str3: {
+    case Op::str3: OP_LABEL(str3) {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x07;
       rb <<= 2;
@@ -2688,11 +3027,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read_register(rd);
       write32(rb, rc);
       INC_STR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //STRB(1)
-    case Op::strb1: {
+    case Op::strb1: OP_LABEL(strb1) {
       rd = (inst >> 0) & 0x07;
       rn = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -2716,11 +3055,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       }
       write16(rb & (~1U), ra & 0xFFFF);
       INC_STRB_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //STRB(2)
-    case Op::strb2: {
+    case Op::strb2: OP_LABEL(strb2) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2744,11 +3083,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       }
       write16(rb & (~1U), ra & 0xFFFF);
       INC_STRB_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //STRH(1)
-    case Op::strh1: {
+    case Op::strh1: OP_LABEL(strh1) {
       rd = (inst >> 0) & 0x07;
       rn = (inst >> 3) & 0x07;
       rb = (inst >> 6) & 0x1F;
@@ -2758,11 +3097,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc=  read_register(rd);
       write16(rb, rc & 0xFFFF);
       INC_STR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //STRH(2)
-    case Op::strh2: {
+    case Op::strh2: OP_LABEL(strh2) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2771,11 +3110,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rc = read_register(rd);
       write16(rb, rc & 0xFFFF);
       INC_STR_CYCLES;
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //SUB(1)
-    case Op::sub1: {
+    case Op::sub1: OP_LABEL(sub1) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rb = (inst >> 6) & 0x7;
@@ -2785,11 +3124,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       do_cvflag(ra, ~rb, 1);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //SUB(2)
-    case Op::sub2: {
+    case Op::sub2: OP_LABEL(sub2) {
       rb = (inst >> 0) & 0xFF;
       rd = (inst >> 8) & 0x07;
       DO_DISS(statusMsg << "subs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
@@ -2798,11 +3137,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       do_cvflag(ra, ~rb, 1);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //SUB(3)
-    case Op::sub3: {
+    case Op::sub3: OP_LABEL(sub3) {
       rd = (inst >> 0) & 0x7;
       rn = (inst >> 3) & 0x7;
       rm = (inst >> 6) & 0x7;
@@ -2813,29 +3152,29 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       write_register(rd, rc);
       do_znflags(rc);
       do_cvflag(ra, ~rb, 1);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //SUB(4)
-    case Op::sub4: {
+    case Op::sub4: OP_LABEL(sub4) {
       rb = inst & 0x7F;
       rb <<= 2;
       DO_DISS(statusMsg << "sub SP,#0x" << Base::HEX2 << rb << endl);
       ra = read_register(13);
       ra -= rb;
       write_register(13, ra);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //SWI
-    case Op::swi: { // never used
+    case Op::swi: OP_LABEL(swi) { // never used
 //      rb = inst & 0xFF;  // NOLINT: clang-analyzer-deadcode.DeadStores
 //      DO_DISS(statusMsg << "swi 0x" << Base::HEX2 << rb << endl);
 //
 //      if(rb == 0xCC)
 //      {
 //        write_register(0, cpsr);
-//        return 0;
+//        NEXT_INSTRUCTION;
 //      }
 //      else
 //      {
@@ -2847,7 +3186,7 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
     }
 
     //SXTB
-    case Op::sxtb: {
+    case Op::sxtb: OP_LABEL(sxtb) {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "sxtb r" << dec << rd << ",r" << dec << rm << endl);
@@ -2856,11 +3195,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       if(rc & 0x80)
         rc |= (~0U) << 8;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //SXTH
-    case Op::sxth: {
+    case Op::sxth: OP_LABEL(sxth) {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "sxth r" << dec << rd << ",r" << dec << rm << endl);
@@ -2869,11 +3208,11 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       if(rc & 0x8000)
         rc |= (~0U) << 16;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //TST
-    case Op::tst: {
+    case Op::tst: OP_LABEL(tst) {
       rn = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "tst r" << dec << rn << ",r" << dec << rm << endl);
@@ -2881,29 +3220,29 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
       rb = read_register(rm);
       rc = ra & rb;
       do_znflags(rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //UXTB
-    case Op::uxtb: {
+    case Op::uxtb: OP_LABEL(uxtb) {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "uxtb r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rm);
       rc = ra & 0xFF;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     //UXTH
-    case Op::uxth: {
+    case Op::uxth: OP_LABEL(uxth) {
       rd = (inst >> 0) & 0x7;
       rm = (inst >> 3) & 0x7;
       DO_DISS(statusMsg << "uxth r" << dec << rd << ",r" << dec << rm << endl);
       ra = read_register(rm);
       rc = ra & 0xFFFF;
       write_register(rd, rc);
-      return 0;
+      NEXT_INSTRUCTION;
     }
 
     // Silence compiler
@@ -2919,12 +3258,29 @@ FORCE_INLINE int Thumbulator::execute()  // NOLINT (readability-function-size)
 #endif
   }
 
+#ifdef THUMB_THREADED_DISPATCH
+op_invalid:
+#endif
 #ifndef UNSAFE_OPTIMIZATIONS
   statusMsg << "invalid instruction " << Base::HEX8 << pc << " " << Base::HEX4 << inst << endl;
 #endif
   return 1;
 }
 
+#ifdef THUMB_THREADED_DISPATCH
+  #pragma GCC diagnostic pop
+#endif
+#undef FETCH_CYCLES
+#undef COUNT_OP
+#undef BEGIN_INSTRUCTION
+#undef FETCH_FROM_BLOCK
+#undef PROFILE_BLOCK
+#undef PROFILE_CALL
+#undef OP_LABEL
+#undef DISPATCH
+#undef NEXT_INSTRUCTION
+
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int Thumbulator::reset()
 {
@@ -29,6 +29,9 @@ class Cartridge;
 
 #include "bspf.hxx"
 #include "Console.hxx"
+#ifdef DEBUGGER_SUPPORT
+  #include "ThumbProfiler.hxx"
+#endif
 
 #ifdef RETRON77
   #define UNSAFE_OPTIMIZATIONS
@@ -45,6 +48,10 @@ class Cartridge;
   #define TIMER_0           // enable timer 0 support (e.g. for measuring cycle count)
 #endif
 
+#if defined(__GNUC__) || defined(__clang__)
+  #define THUMB_THREADED_DISPATCH  // dispatch ops using computed gotos
+#endif
+
 class Thumbulator
 {
   public:
@@ -110,6 +117,10 @@ class Thumbulator
     void lockMamMode(bool lock) { _lockMamcr = lock; }
     MamModeType mamMode() const { return static_cast<MamModeType>(mamcr); }
 
+  #ifdef DEBUGGER_SUPPORT
+    ThumbProfiler& profiler() { return _profiler; }
+  #endif
+
   #ifdef THUMB_CYCLE_COUNT
     void cycleFactor(double factor) { _armCyclesFactor = factor; }
     double cycleFactor() const { return _armCyclesFactor; }
@@ -219,6 +230,9 @@ class Thumbulator
     uInt32 read_register(uInt32 reg);
     void write_register(uInt32 reg, uInt32 data, bool isFlowBreak = true);
 #endif
+  #ifdef THUMB_CYCLE_COUNT
+    void fetchCycles(uInt32 addr);
+  #endif
     uInt32 fetch16(uInt32 addr);
     uInt32 read16(uInt32 addr);
     uInt32 read32(uInt32 addr);
@@ -226,12 +240,33 @@ class Thumbulator
     bool isInvalidROM(uInt32 addr) const;
     bool isInvalidRAM(uInt32 addr) const;
     bool isProtectedRAM(uInt32 addr);
+
+    // Host memory of a 4 KB page of ROM or RAM, which can be read resp.
+    // written without any further checks (nullptr if not possible)
+    struct MemoryPage {
+      const uInt16* read{nullptr};
+      uInt16* write{nullptr};
+    };
+    void mapMemoryPages();
+    const MemoryPage& memoryPage(uInt32 addr) const;
   #endif
     void write16(uInt32 addr, uInt32 data);
+  #ifndef UNSAFE_OPTIMIZATIONS
+    void invalidateRamCode(uInt32 idx);
+    void clearRamCode();
+  #endif
     void write32(uInt32 addr, uInt32 data);
     void updateTimer(uInt32 cycles);
 
-    Op decodeInstructionWord(uint16_t inst, uInt32 pc);
+    Op decodeInstructionWord(uint16_t inst, uInt32 pc, uInt32& param);
+
+    // Get the length of the basic block starting at halfword 'idx' of the
+    // given ROM or RAM region, linking the block if necessary. A block ends
+    // with the first op which may change the program flow (or for code in
+    // RAM, which may also modify memory).
+    uInt32 linkBlock(const uInt16* code, Op* ops, uInt32* params,
+                     uInt16* blockLen, uInt32 idx, uInt32 size, uInt32 base,
+                     bool isRam);
 
     void do_cvflag(uInt32 a, uInt32 b, uInt32 c);
 
@@ -265,6 +300,16 @@ class Thumbulator
     uInt32 cStack{0};
     const unique_ptr<Op[]> decodedRom;  // NOLINT
     const unique_ptr<uInt32[]> decodedParam;  // NOLINT
+    const unique_ptr<uInt16[]> romBlockLen;  // NOLINT
+  #ifndef UNSAFE_OPTIMIZATIONS
+    // Code executed from RAM is decoded on demand (Op::numOps marks halfwords
+    // not decoded yet) and invalidated when it gets overwritten
+    const unique_ptr<Op[]> decodedRam;  // NOLINT
+    const unique_ptr<uInt32[]> decodedRamParam;  // NOLINT
+    const unique_ptr<uInt16[]> ramBlockLen;  // NOLINT
+    bool _ramCodeDecoded{false};
+    bool _ramBlocksValid{true};
+  #endif
     uInt16* ram{nullptr};
     std::array<uInt32, 16> reg_norm; // normal execution mode, do not have a thread mode
     uInt32 znFlags{0};
@@ -304,6 +349,15 @@ class Thumbulator
     bool _countCycles{false};
     bool _lockMamcr{false};
 
+  #ifdef DEBUGGER_SUPPORT
+    ThumbProfiler _profiler;
+
+    // ARM cycles if counted, else instructions executed in the current run
+    uInt64 profilerClock() const {
+      return _countCycles ? _totalCycles : _stats.instructions;
+    }
+  #endif
+
   #ifdef THUMB_CYCLE_COUNT
     double _armCyclesFactor{1.05};
     uInt32 _pipeIdx{0};
@@ -340,6 +394,15 @@ class Thumbulator
       CPSR_C = 1u << 29,
       CPSR_V = 1u << 28;
 
+  #ifndef UNSAFE_OPTIMIZATIONS
+    static constexpr uInt32
+      PAGE_BITS = 12,
+      PAGE_MASK = (1u << PAGE_BITS) - 1,
+      REGION_PAGES = ROMSIZE >> PAGE_BITS;  // pages per ROM resp. RAM region
+
+    std::array<MemoryPage, REGION_PAGES * 2> pageTable;  // ROM, then RAM pages
+  #endif
+
   private:
     // Following constructors and assignment operators not supported
     Thumbulator() = delete;
@@ -174,6 +174,17 @@ class Ball : public Serializable
      */
     FORCE_INLINE void tick(bool isReceivingRegularClock = true);
 
+    /**
+      The number of upcoming clocks during which tick() merely advances the
+      counter, as long as there is no movement and no register write.
+    */
+    FORCE_INLINE uInt32 idleClocks() const;
+
+    /**
+      Process the given number of idle clocks at once (see idleClocks()).
+    */
+    FORCE_INLINE void tickIdle(uInt32 clocks);
+
   public:
 
     /**
@@ -412,4 +423,21 @@ void Ball::tick(bool isReceivingRegularClock)
       myCounter = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Ball::idleClocks() const
+{
+  if (myIsRendering || (myUseInvertedPhaseClock && myInvertedPhaseClock)) return 0;
+
+  // Rendering is triggered at counter value 156 (see above)
+  return (156 + TIAConstants::H_PIXEL - myCounter) % TIAConstants::H_PIXEL;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Ball::tickIdle(uInt32 clocks)
+{
+  mySignalActive = false;
+  collision = myCollisionMaskDisabled;
+  myCounter = (myCounter + clocks) % TIAConstants::H_PIXEL;
+}
+
 #endif // TIA_BALL
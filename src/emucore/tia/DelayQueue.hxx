@@ -43,6 +43,18 @@ class DelayQueue : public Serializable
 
     template<typename T> void execute(T executor);
 
+    /**
+      The number of upcoming clocks for which execute() has nothing to do
+      (or an arbitrary value of at least length if the queue is empty).
+    */
+    uInt32 idleClocks() const;
+
+    /**
+      Advance the queue by the given number of clocks without executing
+      anything. Must not exceed idleClocks().
+    */
+    void skip(uInt32 clocks);
+
     /**
       Serializable methods (see that class for more information).
     */
@@ -118,6 +130,28 @@ void DelayQueue<length, capacity>::execute(T executor)
   myIndex = smartmod<length>(myIndex + 1);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<unsigned length, unsigned capacity>
+uInt32 DelayQueue<length, capacity>::idleClocks() const
+{
+  uInt8 index = myIndex;
+
+  for (uInt32 clocks = 0; clocks < length; ++clocks) {
+    if (myMembers[index].mySize) return clocks;
+
+    index = smartmod<length>(index + 1);
+  }
+
+  return ~0U;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<unsigned length, unsigned capacity>
+void DelayQueue<length, capacity>::skip(uInt32 clocks)
+{
+  myIndex = (myIndex + clocks) % length;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<unsigned length, unsigned capacity>
 bool DelayQueue<length, capacity>::save(Serializer& out) const
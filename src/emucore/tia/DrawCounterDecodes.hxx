@@ -30,6 +30,12 @@ class DrawCounterDecodes
 
     static DrawCounterDecodes& get();
 
+    /**
+      The number of clocks until the draw counter reaches a position at which
+      the given decode table starts a copy (0 if it is at such a position now).
+    */
+    static uInt32 clocksUntilDecode(const uInt8* decodes, uInt8 counter);
+
   protected:
 
     DrawCounterDecodes();
@@ -53,4 +59,23 @@ class DrawCounterDecodes
     DrawCounterDecodes& operator=(DrawCounterDecodes&&) = delete;
 };
 
+// ############################################################################
+// Implementation
+// ############################################################################
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline uInt32 DrawCounterDecodes::clocksUntilDecode(const uInt8* decodes, uInt8 counter)
+{
+  // These are the only positions ever set by the constructor
+  static constexpr std::array<uInt8, 4> positions = { 12, 28, 60, 156 };
+
+  uInt32 clocks = 160;
+
+  for (const uInt8 position: positions)
+    if (decodes[position])
+      clocks = std::min<uInt32>(clocks, (position + 160 - counter) % 160);
+
+  return clocks;
+}
+
 #endif // TIA_DRAW_COUNTER_DECODES
@@ -16,7 +16,6 @@
 //============================================================================
 
 #include "Missile.hxx"
-#include "DrawCounterDecodes.hxx"
 #include "TIA.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -24,6 +24,7 @@ class Player;
 #include "Serializable.hxx"
 #include "bspf.hxx"
 #include "TIAConstants.hxx"
+#include "DrawCounterDecodes.hxx"
 
 class Missile : public Serializable
 {
@@ -80,6 +81,17 @@ class Missile : public Serializable
 
     FORCE_INLINE void tick(uInt8 hclock, bool isReceivingMclock = true);
 
+    /**
+      The number of upcoming clocks during which tick() merely advances the
+      counter, as long as there is no movement and no register write.
+    */
+    FORCE_INLINE uInt32 idleClocks() const;
+
+    /**
+      Process the given number of idle clocks at once (see idleClocks()).
+    */
+    FORCE_INLINE void tickIdle(uInt32 clocks);
+
   public:
 
     uInt32 collision{0};
@@ -200,4 +212,20 @@ void Missile::tick(uInt8 hclock, bool isReceivingMclock)
   if (++myCounter >= TIAConstants::H_PIXEL) myCounter = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Missile::idleClocks() const
+{
+  if (myIsRendering || (myUseInvertedPhaseClock && myInvertedPhaseClock)) return 0;
+
+  return DrawCounterDecodes::clocksUntilDecode(myDecodes, myCounter);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Missile::tickIdle(uInt32 clocks)
+{
+  myIsVisible = false;
+  collision = myCollisionMaskDisabled;
+  myCounter = (myCounter + clocks) % TIAConstants::H_PIXEL;
+}
+
 #endif // TIA_MISSILE
@@ -16,7 +16,6 @@
 //============================================================================
 
 #include "Player.hxx"
-#include "DrawCounterDecodes.hxx"
 #include "TIA.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
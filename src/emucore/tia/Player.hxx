@@ -23,6 +23,7 @@ class TIA;
 #include "bspf.hxx"
 #include "Serializable.hxx"
 #include "TIAConstants.hxx"
+#include "DrawCounterDecodes.hxx"
 
 class Player : public Serializable
 {
@@ -91,6 +92,17 @@ class Player : public Serializable
 
     FORCE_INLINE void tick();
 
+    /**
+      The number of upcoming clocks during which tick() merely advances the
+      counter, as long as there is no movement and no register write.
+    */
+    FORCE_INLINE uInt32 idleClocks() const;
+
+    /**
+      Process the given number of idle clocks at once (see idleClocks()).
+    */
+    FORCE_INLINE void tickIdle(uInt32 clocks);
+
   public:
 
     uInt32 collision{0};
@@ -217,4 +229,19 @@ void Player::tick()
   if (++myCounter >= TIAConstants::H_PIXEL) myCounter = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Player::idleClocks() const
+{
+  if (myIsRendering || (myUseInvertedPhaseClock && myInvertedPhaseClock)) return 0;
+
+  return DrawCounterDecodes::clocksUntilDecode(myDecodes, myCounter);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Player::tickIdle(uInt32 clocks)
+{
+  collision = myCollisionMaskDisabled;
+  myCounter = (myCounter + clocks) % TIAConstants::H_PIXEL;
+}
+
 #endif // TIA_PLAYER
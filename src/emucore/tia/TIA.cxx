@@ -184,9 +184,10 @@ void TIA::initialize()
   myFramesSinceLastRender = 0;
 
   // Blank the various framebuffers; they may contain graphical garbage
-  myBackBuffer.fill(0);
-  myFrontBuffer.fill(0);
-  myFramebuffer.fill(0);
+  for(auto& buffer: myBuffers)
+    buffer.fill(0);
+  myLastFrame = myFrontBuffer;
+  myFrameRendered = false;
 
   applyDeveloperSettings();
 
@@ -356,6 +357,8 @@ bool TIA::load(Serializer& in)
     myHctr = in.getInt();
     myHctrDelta = in.getInt();
     myXAtRenderingStart = in.getInt();
+    // Not part of the state, assume the current frame is being rendered
+    myFrameRendered = true;
 
     myCollisionUpdateRequired = in.getBool();
     myCollisionUpdateScheduled = in.getBool();
@@ -905,9 +908,11 @@ bool TIA::saveDisplay(Serializer& out) const
 {
   try
   {
-    out.putByteArray(myFramebuffer.data(), myFramebuffer.size());
-    out.putByteArray(myBackBuffer.data(), myBackBuffer.size());
-    out.putByteArray(myFrontBuffer.data(), myFrontBuffer.size());
+    const FrameBufferArray* frontBuffer = myFrontBuffer;
+
+    out.putByteArray(myFramebuffer->data(), myFramebuffer->size());
+    out.putByteArray(myBackBuffer->data(), myBackBuffer->size());
+    out.putByteArray(frontBuffer->data(), frontBuffer->size());
     out.putInt(myFramesSinceLastRender);
   }
   catch(...)
@@ -925,10 +930,14 @@ bool TIA::loadDisplay(const Serializer& in)
   try
   {
     // Reset frame buffer pointer and data
-    in.getByteArray(myFramebuffer.data(), myFramebuffer.size());
-    in.getByteArray(myBackBuffer.data(), myBackBuffer.size());
-    in.getByteArray(myFrontBuffer.data(), myFrontBuffer.size());
+    FrameBufferArray* frontBuffer = myFrontBuffer;
+
+    in.getByteArray(myFramebuffer->data(), myFramebuffer->size());
+    in.getByteArray(myBackBuffer->data(), myBackBuffer->size());
+    in.getByteArray(frontBuffer->data(), frontBuffer->size());
     myFramesSinceLastRender = in.getInt();
+
+    myLastFrame = myFramesSinceLastRender > 0 ? frontBuffer : myFramebuffer;
   }
   catch(...)
   {
@@ -1011,7 +1020,7 @@ void TIA::renderToFrameBuffer()
 
   myFramesSinceLastRender = 0;
 
-  myFramebuffer = myFrontBuffer;
+  myFramebuffer = myFrontBuffer.exchange(myFramebuffer);
 
   myFrameBufferScanlines = myFrontBufferScanlines;
 }
@@ -1019,8 +1028,8 @@ void TIA::renderToFrameBuffer()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::clearFrameBuffer()
 {
-  myFramebuffer.fill(0);
-  myFrontBuffer.fill(0);
+  myFramebuffer->fill(0);
+  myFrontBuffer.load()->fill(0);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1384,17 +1393,23 @@ void TIA::onFrameComplete()
   myCyclesAtFrameStart = mySystem->cycles();
 #endif
 
+  // If not a single line was rendered, the frame repeats the last one
+  if (!myFrameRendered)
+    *myBackBuffer = *myLastFrame;
+  myFrameRendered = false;
+
   if (myXAtRenderingStart > 0)
-    std::fill_n(myBackBuffer.begin(), myXAtRenderingStart, 0);
+    std::fill_n(myBackBuffer->begin(), myXAtRenderingStart, 0);
 
   // Blank out any extra lines not drawn this frame
   const Int32 missingScanlines = myFrameManager->missingScanlines();
   if (missingScanlines > 0)
-    std::fill_n(myBackBuffer.begin() +
+    std::fill_n(myBackBuffer->begin() +
       static_cast<size_t>(TIAConstants::H_PIXEL * myFrameManager->getY()),
       missingScanlines * TIAConstants::H_PIXEL, 0);
 
-  myFrontBuffer = myBackBuffer;
+  myLastFrame = myBackBuffer;
+  myBackBuffer = myFrontBuffer.exchange(myBackBuffer);
 
   myFrontBufferScanlines = scanlinesLastFrame();
 
@@ -1417,6 +1432,21 @@ void TIA::cycle(uInt32 colorClocks)
 {
   for (uInt32 i = 0; i < colorClocks; ++i)
   {
+    // Try to process a whole span of clocks at once; if that fails, we don't
+    // retry for a few clocks in order to keep the overhead low
+    if (mySpanHoldoff > 0)
+      --mySpanHoldoff;
+    else {
+      const uInt32 clocks = tickSpan(colorClocks - i);
+
+      if (clocks > 0) {
+        i += clocks - 1;
+        continue;
+      }
+
+      mySpanHoldoff = 7;
+    }
+
     myDelayQueue.execute(
       [this] (uInt8 address, uInt8 value) {delayedWrite(address, value);}
     );
@@ -1517,6 +1547,116 @@ void TIA::tickHframe()
     renderPixel(x, y);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TIA::tickSpan(uInt32 maxClocks)
+{
+  // The last clock of the line is always left to the regular path in order
+  // to handle the line change
+  uInt32 clocks = std::min<uInt32>(maxClocks, TIAConstants::H_CLOCKS - 1 - myHctr);
+
+  if (myLinesSinceChange >= 2)
+    return tickQuietSpan(clocks);
+
+  if (myMovementInProgress) return 0;
+
+  // Without movement, nothing happens in hblank before it ends
+  if (myHstate == HState::blank)
+    return myHctr > 0 && myHctr < TIAConstants::H_BLANK_CLOCKS - 1
+      ? tickQuietSpan(std::min<uInt32>(clocks, TIAConstants::H_BLANK_CLOCKS - 1 - myHctr))
+      : 0;
+
+  // During the visible part of the line, the span ends before any sprite
+  // starts drawing and before the next delayed write
+  if ((clocks = std::min(clocks, myPlayer0.idleClocks())) == 0 ||
+      (clocks = std::min(clocks, myPlayer1.idleClocks())) == 0 ||
+      (clocks = std::min(clocks, myMissile0.idleClocks())) == 0 ||
+      (clocks = std::min(clocks, myMissile1.idleClocks())) == 0 ||
+      (clocks = std::min(clocks, myBall.idleClocks())) == 0 ||
+      (clocks = std::min(clocks, myDelayQueue.idleClocks())) == 0)
+    return 0;
+
+  myDelayQueue.skip(clocks);
+
+  myPlayer0.tickIdle(clocks);
+  myPlayer1.tickIdle(clocks);
+  myMissile0.tickIdle(clocks);
+  myMissile1.tickIdle(clocks);
+  myBall.tickIdle(clocks);
+
+  // With all sprites invisible, only playfield and background contribute to
+  // the picture, and only the playfield changes the collision mask
+  const uInt32 spriteCollision =
+    myPlayer0.collision &
+    myPlayer1.collision &
+    myMissile0.collision &
+    myMissile1.collision &
+    myBall.collision;
+  const bool vblank = myFrameManager->vblank();
+  const bool rendering = myFrameManager->isRendering();
+  const uInt8 backgroundColor = vblank ? 0 : myBackground.getColor();
+  uInt8* pixels = myBackBuffer->data() +
+    static_cast<size_t>(myFrameManager->getY()) * TIAConstants::H_PIXEL;
+  uInt32 collisionMask = 0;
+  uInt32 x = myHctr - TIAConstants::H_BLANK_CLOCKS - myHctrDelta;
+
+  for (const uInt32 end = x + clocks; x != end; ++x)
+  {
+    myPlayfield.tick(x);
+    collisionMask |= myPlayfield.collision;
+
+    if (rendering && x < TIAConstants::H_PIXEL) {
+      const uInt8 color = (!vblank && myPlayfield.isOn())
+        ? myPlayfield.getColor() : backgroundColor;
+
+      pixels[x] = color;
+      if (myIsLayoutDetector)
+        myFrameManager->pixelColor(color);
+    }
+  }
+
+  if (!vblank) myCollisionMask |= spriteCollision & collisionMask;
+
+  myHctr += clocks;
+  myTimestamp += clocks;
+
+#ifdef SOUND_SUPPORT
+  for (uInt32 i = 0; i < clocks; ++i)
+    myAudio.tick();
+#endif
+
+  myCollisionUpdateRequired = true;
+  myCollisionUpdateScheduled = false;
+
+  return clocks;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TIA::tickQuietSpan(uInt32 maxClocks)
+{
+  const uInt32 clocks = std::min(maxClocks, myDelayQueue.idleClocks());
+
+  if (clocks == 0) return 0;
+
+  myDelayQueue.skip(clocks);
+
+  // Only the first clock may pick up a scheduled collision update
+  if (myCollisionUpdateScheduled && myLinesSinceChange < 2 && !myFrameManager->vblank())
+    updateCollision();
+
+  myCollisionUpdateRequired = clocks == 1 && myCollisionUpdateScheduled;
+  myCollisionUpdateScheduled = false;
+
+  myHctr += clocks;
+  myTimestamp += clocks;
+
+#ifdef SOUND_SUPPORT
+  for (uInt32 i = 0; i < clocks; ++i)
+    myAudio.tick();
+#endif
+
+  return clocks;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::applyRsync()
 {
@@ -1525,7 +1665,7 @@ void TIA::applyRsync()
 
   myHctrDelta = TIAConstants::H_CLOCKS - 3 - myHctr;
   if (myFrameManager->isRendering())
-    std::fill_n(myBackBuffer.begin() +
+    std::fill_n(myBackBuffer->begin() +
       static_cast<size_t>(myFrameManager->getY() * TIAConstants::H_PIXEL + x),
       TIAConstants::H_PIXEL - x, 0);
 
@@ -1546,6 +1686,8 @@ FORCE_INLINE void TIA::nextLine()
   myHstate = HState::blank;
   myHctrDelta = 0;
 
+  myFrameRendered |= myFrameManager->isRendering();
+
   myFrameManager->nextLine();
   myMissile0.nextLine();
   myMissile1.nextLine();
@@ -1566,7 +1708,7 @@ void TIA::cloneLastLine()
   {
     // y is always 0 in FrameLayoutDetector
     for(uInt32 i = 0 ; i < TIAConstants::H_PIXEL; ++i)
-      myFrameManager->pixelColor(myBackBuffer[i]);
+      myFrameManager->pixelColor((*myBackBuffer)[i]);
   }
   else
   {
@@ -1574,8 +1716,8 @@ void TIA::cloneLastLine()
 
     if(!myFrameManager->isRendering() || y == 0) return;
 
-    std::copy_n(myBackBuffer.begin() + (y - 1) * TIAConstants::H_PIXEL,
-      TIAConstants::H_PIXEL, myBackBuffer.begin() + y * TIAConstants::H_PIXEL);
+    std::copy_n(myBackBuffer->begin() + (y - 1) * TIAConstants::H_PIXEL,
+      TIAConstants::H_PIXEL, myBackBuffer->begin() + y * TIAConstants::H_PIXEL);
   }
 }
 
@@ -1653,7 +1795,7 @@ FORCE_INLINE void TIA::renderPixel(uInt32 x, uInt32 y)
     }
   }
 
-  myBackBuffer[y * TIAConstants::H_PIXEL + x] = color;
+  (*myBackBuffer)[y * TIAConstants::H_PIXEL + x] = color;
   if (myIsLayoutDetector)
     myFrameManager->pixelColor(color);
 }
@@ -1681,7 +1823,7 @@ void TIA::flushLineCache()
 void TIA::clearHmoveComb()
 {
   if (myFrameManager->isRendering() && myHstate == HState::blank)
-    std::fill_n(myBackBuffer.begin() +
+    std::fill_n(myBackBuffer->begin() +
       static_cast<size_t>(myFrameManager->getY() * TIAConstants::H_PIXEL),
       8, myColorHBlank);
 }
@@ -19,6 +19,7 @@
 #define TIA_TIA
 
 #include <functional>
+#include <atomic>
 
 #include "bspf.hxx"
 #include "ConsoleIO.hxx"
@@ -243,12 +244,18 @@ class TIA : public Device
       Return the buffer that holds the currently drawing TIA frame
       (the TIA output widget needs this).
      */
-    uInt8* outputBuffer() { return myBackBuffer.data(); }
+    uInt8* outputBuffer() { return myBackBuffer->data(); }
+
+    /**
+      Return the buffer that holds the last completed TIA frame, which
+      is continued below the current beam position of the output buffer.
+     */
+    const uInt8* lastFrameBuffer() const { return myLastFrame->data(); }
 
     /**
       Returns a pointer to the internal frame buffer.
     */
-    uInt8* frameBuffer() { return myFramebuffer.data(); }
+    uInt8* frameBuffer() { return myFramebuffer->data(); }
 
     void clearFrameBuffer();
 
@@ -640,6 +647,22 @@ class TIA : public Device
      */
     void tickHframe();
 
+    /**
+     * Advance up to maxClocks clocks at once, provided that nothing but the
+     * counters, the playfield and the background changes during them (no
+     * sprite is drawn, nothing is moving and no delayed write is due). Returns
+     * the number of clocks processed, or 0 if the next clock has to go through
+     * the regular path.
+     */
+    uInt32 tickSpan(uInt32 maxClocks);
+
+    /**
+     * Advance up to maxClocks clocks during which no object is ticked (hblank
+     * without movement or a cached line). Returns the number of clocks
+     * processed.
+     */
+    uInt32 tickQuietSpan(uInt32 maxClocks);
+
     /**
      * Update the collision bitfield.
      */
@@ -823,16 +846,31 @@ class TIA : public Device
     LatchedInput myInput0;
     LatchedInput myInput1;
 
-    // Pointer to the internal color-index-based frame buffer
-    std::array<uInt8, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight> myFramebuffer;
+    using FrameBufferArray =
+      std::array<uInt8, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight>;
+
+    // Storage for the color-index-based triple buffer
+    std::array<FrameBufferArray, 3> myBuffers;
+
+    // The frame is rendered to the back buffer. Upon completion, the back
+    // buffer is exchanged with the front buffer, which in turn is exchanged
+    // with the frame buffer when rendering. Only the pointers are swapped,
+    // the pixel data is never copied. The front buffer is the only buffer
+    // accessed by both sides, so it is exchanged atomically.
+    FrameBufferArray* myBackBuffer{&myBuffers[0]};
+    std::atomic<FrameBufferArray*> myFrontBuffer{&myBuffers[1]};
+    FrameBufferArray* myFramebuffer{&myBuffers[2]};
+
+    // The buffer holding the last completed frame (either the front buffer
+    // or the frame buffer); lines not rendered in the current frame keep
+    // its contents
+    const FrameBufferArray* myLastFrame{&myBuffers[1]};
 
-    // The frame is rendered to the backbuffer and only copied to the framebuffer
-    // upon completion
-    std::array<uInt8, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight> myBackBuffer;
-    std::array<uInt8, TIAConstants::H_PIXEL * TIAConstants::frameBufferHeight> myFrontBuffer;
+    // Whether any line has been rendered since the last frame was completed
+    bool myFrameRendered{false};
 
-    // We snapshot frame statistics when the back buffer is copied to the front buffer
-    // and when the front buffer is copied to the frame buffer
+    // We snapshot frame statistics when the back buffer is swapped with the front buffer
+    // and when the front buffer is swapped with the frame buffer
     uInt32 myFrontBufferScanlines{0}, myFrameBufferScanlines{0};
 
     // Frames since the last time a frame was rendered to the render buffer
@@ -858,6 +896,13 @@ class TIA : public Device
      */
     uInt8 myHctr{0};
 
+    /**
+     * The number of clocks before the next attempt to process a span of clocks
+     * at once (see tickSpan()). This is a pure optimization and not part of
+     * the emulation state.
+     */
+    uInt8 mySpanHoldoff{0};
+
     /**
      * Delta between master line counter and actual color clock. Nonzero after
      * RSYNC (before the scanline terminates)
@@ -16,11 +16,11 @@
 //============================================================================
 
 #include <cctype>
+#include <numeric>
 
 #include "ScrollBarWidget.hxx"
 #include "FileListWidget.hxx"
 #include "TimerManager.hxx"
-#include "ProgressDialog.hxx"
 #include "FBSurface.hxx"
 #include "Bankswitch.hxx"
 
@@ -36,6 +36,12 @@ FileListWidget::FileListWidget(GuiObject* boss, const GUI::Font& font,
   setTarget(this);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FileListWidget::~FileListWidget()
+{
+  stopLoading();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FileListWidget::setDirectory(const FSNode& node, string_view select)
 {
@@ -78,61 +84,47 @@ void FileListWidget::setDirectory(const FSNode& node, string_view select)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FileListWidget::setLocation(const FSNode& node, string_view select)
 {
-  progress().resetProgress();
-  progress().open();
-  FSNode::CancelCheck isCancelled = [this]() {
-    return myProgressDialog->isCancelled();
-  };
+  stopLoading();
 
   _node = node;
 
   // Read in the data from the file system (start with an empty list)
   _fileList.clear();
-
-  getChildren(isCancelled);
-
-  // Now fill the list widget with the names from the file list,
-  // even if cancelled
-  StringList list;
-  const size_t orgLen = _node.getShortPath().length();
-
   _dirList.clear();
   _iconTypeList.clear();
+  _list.clear();
 
-  for(const auto& file : _fileList)
-  {
-    const string& path = file.getShortPath();
-    const string& name = file.getName();
+  // Entries added directly are always shown at the top
+  getChildren();
 
-    // display only relative path in tooltip
-    if(path.length() >= orgLen && !fullPathToolTip())
-      _dirList.push_back(path.substr(orgLen));
-    else
-      _dirList.push_back(path);
+  FSList files;
+  files.swap(_fileList);
+  for(const auto& file : files)
+    addChild(file, _node.getShortPath().length());
+  extendLists(_list);
+  _fixedEntries = _fileList.size();
 
-    if(file.isDirectory() && !BSPF::endsWithIgnoreCase(name, ".zip"))
-    {
-      list.push_back(name);
-      if(name == "..")
-        _iconTypeList.push_back(IconType::updir);
-      else
-        _iconTypeList.push_back(getIconType(file.getPath()));
-    }
-    else
-    {
-      const string& displayName = _showFileExtensions ? name : file.getNameWithExt(EmptyString);
+  // Wait a bit, so that small directories are shown at once
+  if(_loading)
+  {
+    std::unique_lock<std::mutex> lock(_loaderMutex);
+    _loaderDoneCond.wait_for(lock, std::chrono::milliseconds(SYNC_LOAD_TIME),
+                             [this]{ return _loaderDone; });
+    lock.unlock();
 
-      list.push_back(displayName);
-      _iconTypeList.push_back(getIconType(file.getPath()));
-    }
+    addLoadedChildren();
   }
-  extendLists(list);
+  ListWidget::recalc();
 
-  setList(list);
+  // Select the entry, or the first one until the entry has been read
+  _autoSelect = true;
   setSelected(select);
-  ListWidget::recalc();
+  _autoSelect = false;
 
-  progress().close();
+  if(_loading && !select.empty() && (_list.empty() || _list[_selectedItem] != select))
+    _loadSelect = select;
+  else if(!_loading)
+    childrenLoaded();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -142,26 +134,209 @@ bool FileListWidget::isDirectory(const FSNode& node) const
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void FileListWidget::getChildren(const FSNode::CancelCheck& isCancelled)
+void FileListWidget::getChildren()
 {
+  if(!_node.isDirectory())
+    return;
+
+  // Add parent node, if it is valid to do so
+  if(_node.hasParent())
+  {
+    FSNode parent = _node.getParent();
+    parent.setName("..");
+    _fileList.emplace_back(parent);
+  }
+  startLoading();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FileListWidget::startLoading()
+{
+  _loaderCancelled = false;
+  _loaderDone = false;
+  _loading = true;
+
+  _loader = std::thread([this, node = _node, mode = _fsmode, filter = _filter,
+                         subDirs = _includeSubDirs]()
+  {
+    const FSNode::CancelCheck isCancelled = [this]() {
+      return _loaderCancelled.load();
+    };
+    // Pass on the entries as soon as they are accepted by the filter;
+    // when including subdirectories, they are not sorted yet.
+    // Returning false keeps getChildren() from collecting them a second time.
+    const FSNode::NameFilter addEntry = [&](const FSNode& file) {
+      if(filter(file))
+      {
+        const std::lock_guard<std::mutex> lock(_loaderMutex);
+        _loadedList.push_back(file);
+      }
+      return false;
+    };
+    FSList files;
+
+    node.getChildren(files, mode, addEntry, subDirs, false, isCancelled);
+
+    {
+      const std::lock_guard<std::mutex> lock(_loaderMutex);
+      _loaderDone = true;
+    }
+    _loaderDoneCond.notify_all();
+  });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FileListWidget::stopLoading()
+{
+  if(_loader.joinable())
+  {
+    _loaderCancelled = true;
+    _loader.join();
+  }
+  _loadedList.clear();
+  _loading = false;
+  _loadSelect.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FileListWidget::addLoadedChildren()
+{
+  FSList files;
+  bool done = false;
+  {
+    const std::lock_guard<std::mutex> lock(_loaderMutex);
+
+    files.swap(_loadedList);
+    done = _loaderDone;
+  }
+  if(files.empty() && !done)
+    return;
+
+  if(!files.empty())
+  {
+    addChildren(files);
+    ListWidget::recalc();
+    setDirty();
+
+    // Select the entry requested, unless the user has changed the selection
+    if(!_loadSelect.empty())
+    {
+      const auto iter = std::find(_list.begin(), _list.end(), _loadSelect);
+      if(iter != _list.end())
+      {
+        _autoSelect = true;
+        setSelected(static_cast<int>(iter - _list.begin()));
+        _autoSelect = false;
+        _loadSelect.clear();
+      }
+    }
+  }
+  if(done)
+  {
+    _loader.join();
+    _loading = false;
+    _loadSelect.clear();
+    childrenLoaded();
+  }
+
+  // Let the boss know about the new entries
+  setTarget(_boss);
+  sendCommand(ListChanged, 0, 0);
+  setTarget(this);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FileListWidget::addChildren(FSList& files)
+{
+  const auto compare = [](const FSNode& node1, const FSNode& node2)
+  {
+    if(node1.isDirectory() != node2.isDirectory())
+      return node1.isDirectory();
+    else
+      return BSPF::compareIgnoreCase(node1.getName(), node2.getName()) < 0;
+  };
+  const size_t orgLen = _node.getShortPath().length();
+  const size_t first = _fileList.size();
+
+  // When including subdirectories, the entries are read unsorted
   if(_includeSubDirs)
+    std::sort(files.begin(), files.end(), compare);
+
+  for(const auto& file : files)
+    addChild(file, orgLen);
+
+  if(!_includeSubDirs || first == _fixedEntries)
+    return;
+
+  // Merge the new entries with the already sorted ones
+  vector<size_t> order(_fileList.size() - _fixedEntries);
+  std::iota(order.begin(), order.end(), _fixedEntries);
+  std::inplace_merge(order.begin(), order.begin() + (first - _fixedEntries),
+                     order.end(), [&](size_t i, size_t j) {
+    return compare(_fileList[i], _fileList[j]);
+  });
+
+  const auto reorder = [&](auto& entries)
+  {
+    std::remove_reference_t<decltype(entries)> sorted;
+
+    sorted.reserve(entries.size());
+    std::move(entries.begin(), entries.begin() + _fixedEntries,
+              std::back_inserter(sorted));
+    for(const auto i : order)
+      sorted.push_back(std::move(entries[i]));
+    entries = std::move(sorted);
+  };
+  reorder(_fileList);
+  reorder(_dirList);
+  reorder(_iconTypeList);
+  reorder(_list);
+
+  // Keep the selected entry selected, at the same position on screen
+  if(_selectedItem >= static_cast<int>(_fixedEntries))
   {
-    // Actually this could become HUGE
-    _fileList.reserve(0x2000);
-    _node.getAllChildren(_fileList, _fsmode, _filter, true, isCancelled);
+    const auto iter = std::find(order.begin(), order.end(), _selectedItem);
+    const int selected = static_cast<int>(iter - order.begin() + _fixedEntries);
+
+    _currentPos += selected - _selectedItem;
+    _selectedItem = selected;
+    _selected = selected;
   }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FileListWidget::addChild(const FSNode& file, size_t orgLen)
+{
+  const string& path = file.getShortPath();
+  const string& name = file.getName();
+
+  // display only relative path in tooltip
+  if(path.length() >= orgLen && !fullPathToolTip())
+    _dirList.push_back(path.substr(orgLen));
   else
+    _dirList.push_back(path);
+
+  if(file.isDirectory() && !BSPF::endsWithIgnoreCase(name, ".zip"))
   {
-    _fileList.reserve(0x200);
-    _node.getChildren(_fileList, _fsmode, _filter, false, true, isCancelled);
+    _list.push_back(name);
+    if(name == "..")
+      _iconTypeList.push_back(IconType::updir);
+    else
+      _iconTypeList.push_back(getIconType(file));
   }
+  else
+  {
+    const string& displayName = _showFileExtensions ? name : file.getNameWithExt(EmptyString);
+
+    _list.push_back(displayName);
+    _iconTypeList.push_back(getIconType(file));
+  }
+  _fileList.push_back(file);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-FileListWidget::IconType FileListWidget::getIconType(string_view path) const
+FileListWidget::IconType FileListWidget::getIconType(const FSNode& node) const
 {
-  const FSNode node(path);
-
   if(node.isDirectory())
   {
     return BSPF::endsWithIgnoreCase(node.getName(), ".zip")
@@ -298,18 +473,11 @@ const FSNode& FileListWidget::selected()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-ProgressDialog& FileListWidget::progress()
-{
-  if(myProgressDialog == nullptr)
-    myProgressDialog = make_unique<ProgressDialog>(this, _font, "");
-
-  return *myProgressDialog;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void FileListWidget::incProgress()
+const FSNode& FileListWidget::getNode(int item) const
 {
-  progress().incProgress();
+  return item >= 0 && item < static_cast<int>(_fileList.size())
+    ? _fileList[item]
+    : ourDefaultNode;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -359,6 +527,15 @@ bool FileListWidget::handleKeyDown(StellaKey key, StellaMod mod)
   return handled;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FileListWidget::tick()
+{
+  if(_loading)
+    addLoadedChildren();
+
+  StringListWidget::tick();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FileListWidget::handleText(char text)
 {
@@ -427,6 +604,8 @@ void FileListWidget::handleCommand(CommandSender* sender, int cmd, int data, int
 
     case ListWidget::kSelectionChangedCmd:
       _selected = data;
+      if(!_autoSelect)
+        _loadSelect.clear();
       cmd = ItemChanged;
       break;
 
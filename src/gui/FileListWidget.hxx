@@ -19,7 +19,11 @@
 #define FILE_LIST_WIDGET_HXX
 
 class CommandSender;
-class ProgressDialog;
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include "FSNode.hxx"
 #include "Stack.hxx"
@@ -39,6 +43,11 @@ class ProgressDialog;
 
   Widgets wishing to enforce their own filename filtering are able
   to use a 'NameFilter' as described below.
+
+  Directories are read in a background thread, and their entries are
+  added to the list in batches while reading.  Small directories are
+  usually complete when setDirectory() etc. return; otherwise, the
+  ListChanged signal is emitted whenever entries were added.
 */
 class FileListWidget : public StringListWidget
 {
@@ -46,6 +55,7 @@ class FileListWidget : public StringListWidget
     enum {
       ItemChanged   = 'FLic',  // Entry in the list is changed (single-click, etc)
       ItemActivated = 'FLac',  // Entry in the list is activated (double-click, etc)
+      ListChanged   = 'FLlc',  // Entries were added to the list while reading
       kHomeDirCmd   = 'homc',  // go to Home directory
       kPrevDirCmd   = 'prvc',  // go back in history to previous directory
       kNextDirCmd   = 'nxtc'   // go back in history to next directory
@@ -55,14 +65,16 @@ class FileListWidget : public StringListWidget
   public:
     FileListWidget(GuiObject* boss, const GUI::Font& font,
                    int x, int y, int w, int h);
-    ~FileListWidget() override = default;
+    ~FileListWidget() override;
 
     bool handleKeyDown(StellaKey key, StellaMod mod) override;
+    void tick() override;
 
     string getToolTip(const Common::Point& pos) const override;
 
     /** Determines how to display files/folders; either setDirectory or reload
-        must be called after any of these are called. */
+        must be called after any of these are called.
+        Note that the name filter is called from a background thread. */
     void setListMode(FSNode::ListMode mode) { _fsmode = mode; }
     void setNameFilter(const FSNode::NameFilter& filter) {
       _filter = filter;
@@ -97,16 +109,18 @@ class FileListWidget : public StringListWidget
     /** Reload current location (file or directory) */
     void reload();
 
+    /** Answer whether the current directory is still being read */
+    bool isLoading() const { return _loading; }
+
     /** Gets current node(s) */
     const FSNode& selected();
     const FSNode& currentDir() const { return _node; }
+    /** Gets the node of any entry, e.g. for looking ahead */
+    const FSNode& getNode(int item) const;
 
     static void setQuickSelectDelay(uInt64 time) { _QUICK_SELECT_DELAY = time; }
     uInt64 getQuickSelectDelay() const { return _QUICK_SELECT_DELAY; }
 
-    ProgressDialog& progress();
-    void incProgress();
-
   protected:
     struct HistoryType
     {
@@ -144,15 +158,23 @@ class FileListWidget : public StringListWidget
     /** Select next directory in history (if applicable) */
     void selectNextHistory();
     virtual bool isDirectory(const FSNode& node) const;
-    virtual void getChildren(const FSNode::CancelCheck& isCancelled);
+    /** Fill the file list, or start reading it in the background */
+    virtual void getChildren();
+    /** Called when all entries of the file list have been read */
+    virtual void childrenLoaded() { }
     virtual void extendLists(StringList& list) { }
-    virtual IconType getIconType(string_view path) const;
+    virtual IconType getIconType(const FSNode& node) const;
     virtual const Icon* getIcon(int i) const;
     int iconWidth() const;
     virtual bool fullPathToolTip() const { return false; }
     static string& fixPath(string& path);
     void addHistory(const FSNode& node);
 
+    /** Read the children of the current directory in the background */
+    void startLoading();
+    /** Stop reading in the background, and discard the remaining entries */
+    void stopLoading();
+
   protected:
     FSNode _node;
     FSList _fileList;
@@ -169,6 +191,13 @@ class FileListWidget : public StringListWidget
     void handleCommand(CommandSender* sender, int cmd, int data, int id) override;
     int drawIcon(int i, int x, int y, ColorId color) override;
 
+    /** Add the entries read in the background so far to the lists */
+    void addLoadedChildren();
+    /** Add the given entries to the lists, sorting them in if necessary */
+    void addChildren(FSList& files);
+    /** Add the given entry to the end of the lists */
+    void addChild(const FSNode& file, size_t orgLen);
+
   private:
     FSNode::ListMode _fsmode{FSNode::ListMode::All};
     bool _includeSubDirs{false};
@@ -184,7 +213,20 @@ class FileListWidget : public StringListWidget
     uInt64 _quickSelectTime{0};
     static uInt64 _QUICK_SELECT_DELAY;
 
-    unique_ptr<ProgressDialog> myProgressDialog;
+    // Reading directories in the background
+    std::thread _loader;
+    std::mutex _loaderMutex;
+    std::condition_variable _loaderDoneCond;
+    std::atomic_bool _loaderCancelled{false};
+    FSList _loadedList;         // entries read, but not added to the lists yet
+    bool _loaderDone{false};    // reading has finished (protected by mutex)
+    bool _loading{false};       // reading is in progress
+    size_t _fixedEntries{0};    // entries at the top, excluded from sorting
+    string _loadSelect;         // entry to select once it has been read
+    bool _autoSelect{false};    // selection is being changed by the widget
+
+    // Time to wait for small directories to be read completely
+    static constexpr uInt32 SYNC_LOAD_TIME = 100;  // milliseconds
 
     static FSNode ourDefaultNode;
 
@@ -0,0 +1,306 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2023 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifdef IMAGE_SUPPORT
+
+#include "FrameBuffer.hxx"
+#include "Variant.hxx"
+#include "JPGLibrary.hxx"
+#include "PNGLibrary.hxx"
+
+#include "ImageCache.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ImageCache::ImageCache(const FrameBuffer& fb)
+  : myFB{fb}
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ImageCache::~ImageCache()
+{
+  {
+    const std::lock_guard<std::mutex> lock(myMutex);
+
+    myQuit = true;
+  }
+  myWakeup.notify_all();
+
+  for(auto& thread: myThreads)
+    thread.join();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ImageCache::setMaxSize(const Common::Size& size)
+{
+  if(size != myMaxSize)
+  {
+    clear();
+
+    const std::lock_guard<std::mutex> lock(myMutex);
+
+    myMaxSize = size;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ImageCache::get(const StringList& fileNames, ImagePtr& image)
+{
+  const std::lock_guard<std::mutex> lock(myMutex);
+
+  return request(fileNames, image, false);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ImageCache::prefetch(const StringList& fileNames)
+{
+  const std::lock_guard<std::mutex> lock(myMutex);
+  ImagePtr image;
+
+  request(fileNames, image, true);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ImageCache::cancel()
+{
+  const std::lock_guard<std::mutex> lock(myMutex);
+
+  for(const auto& names: myQueue)
+    myPending.erase(names.front());
+  myQueue.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ImageCache::clear()
+{
+  cancel();
+
+  const std::lock_guard<std::mutex> lock(myMutex);
+
+  myImages.clear();
+  myIndex.clear();
+  myCacheSize = 0;
+  ++myGeneration;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ImageCache::request(const StringList& fileNames, ImagePtr& image,
+                         bool prefetch)
+{
+  for(auto name = fileNames.cbegin(); name != fileNames.cend(); ++name)
+  {
+    const auto iter = myIndex.find(*name);
+
+    if(iter != myIndex.end())
+    {
+      // Mark as most recently used
+      myImages.splice(myImages.begin(), myImages, iter->second);
+      image = *iter->second;
+      if(image->isValid())
+        return true;
+      continue;
+    }
+
+    // Decode this and the remaining alternatives, unless already requested
+    if(myPending.insert(*name).second)
+    {
+      if(prefetch)
+        myQueue.emplace_back(name, fileNames.cend());
+      else
+        myQueue.emplace_front(name, fileNames.cend());
+
+      if(myThreads.empty())
+      {
+        // Leave one core for the UI; JPG images are decoded one at a time anyway
+        const uInt32 numThreads =
+          BSPF::clamp(std::thread::hardware_concurrency(), 2U, 3U) - 1;
+
+        for(uInt32 i = 0; i < numThreads; ++i)
+          myThreads.emplace_back(&ImageCache::threadMain, this);
+      }
+      myWakeup.notify_one();
+    }
+    return false;
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ImageCache::store(const ImagePtr& image)
+{
+  myImages.push_front(image);
+  myIndex[image->fileName] = myImages.begin();
+  myCacheSize += imageSize(*image);
+
+  // Discard the least recently used images, but keep the new one
+  while(myCacheSize > MAX_CACHE_SIZE && myImages.size() > 1)
+  {
+    const ImagePtr& oldest = myImages.back();
+
+    myCacheSize -= imageSize(*oldest);
+    myIndex.erase(oldest->fileName);
+    myImages.pop_back();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t ImageCache::imageSize(const Image& image)
+{
+  return sizeof(Image) + image.fileName.size() + image.label.size() +
+    image.errorMsg.size() + image.pixels.size() * sizeof(uInt32);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ImageCache::ImagePtr ImageCache::decode(const string& fileName,
+                                        const Common::Size& maxSize) const
+{
+  auto image = make_shared<Image>();
+
+  image->fileName = fileName;
+  try
+  {
+    ByteArray data;
+    Common::Size size;
+    VariantList metaData;
+    const string::size_type idx = fileName.find_last_of('.');
+
+    if(idx != string::npos && fileName.substr(idx + 1) == "png")
+    {
+      PNGLibrary::loadImage(fileName, data, size, metaData);
+
+      // Retrieve label for loaded image
+      for(const auto& meta: metaData)
+      {
+        if(meta.first == "Title")
+        {
+          image->label = meta.second.toString();
+          break;
+        }
+        if(meta.first == "Software"
+            && meta.second.toString().find("Stella") == 0)
+          image->label = "Snapshot"; // default for Stella snapshots with missing "Title" meta data
+      }
+    }
+    else
+    {
+      JPGLibrary::loadImage(fileName, data, size, metaData);
+
+      // Retrieve label for loaded image
+      for(const auto& meta: metaData)
+      {
+        if(meta.first == "ImageDescription")
+        {
+          image->label = meta.second.toString();
+          break;
+        }
+      }
+    }
+    if(!size.valid())
+      throw runtime_error("Invalid image size");
+
+    // Scale down to the maximum size, keeping the aspect ratio
+    const float scale = !maxSize.valid() ? 1.F : std::min({1.F,
+      static_cast<float>(maxSize.w) / size.w,
+      static_cast<float>(maxSize.h) / size.h});
+    const uInt32 w = std::max(1U, static_cast<uInt32>(size.w * scale));
+    const uInt32 h = std::max(1U, static_cast<uInt32>(size.h * scale));
+
+    image->size = Common::Size(w, h);
+    image->pixels.resize(static_cast<size_t>(w) * h);
+
+    // Average all source pixels covered by a target pixel, and convert the
+    // result into the framebuffer format
+    uInt32* p_ptr = image->pixels.data();
+    for(uInt32 y = 0; y < h; ++y)
+    {
+      const uInt32 y0 = y * size.h / h;
+      const uInt32 y1 = std::max(y0 + 1, (y + 1) * size.h / h);
+
+      for(uInt32 x = 0; x < w; ++x)
+      {
+        const uInt32 x0 = x * size.w / w;
+        const uInt32 x1 = std::max(x0 + 1, (x + 1) * size.w / w);
+        const uInt32 count = (y1 - y0) * (x1 - x0);
+        uInt32 r = 0, g = 0, b = 0, a = 0;
+
+        for(uInt32 sy = y0; sy < y1; ++sy)
+        {
+          const uInt8* s_ptr = data.data() + (static_cast<size_t>(sy) * size.w + x0) * 4;
+
+          for(uInt32 sx = x0; sx < x1; ++sx)
+          {
+            r += *s_ptr++;
+            g += *s_ptr++;
+            b += *s_ptr++;
+            a += *s_ptr++;
+          }
+        }
+        *p_ptr++ = myFB.mapRGBA(r / count, g / count, b / count, a / count);
+      }
+    }
+  }
+  catch(const runtime_error& e)
+  {
+    image->errorMsg = e.what();
+    image->label.clear();
+  }
+  return image;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ImageCache::threadMain()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+
+  while(true)
+  {
+    myWakeup.wait(lock, [this]{ return myQuit || !myQueue.empty(); });
+    if(myQuit)
+      break;
+
+    const StringList fileNames = std::move(myQueue.front());
+    myQueue.pop_front();
+
+    // Decode the alternatives until one can be loaded
+    for(const auto& fileName: fileNames)
+    {
+      const auto iter = myIndex.find(fileName);
+
+      if(iter != myIndex.end())
+      {
+        if((*iter->second)->isValid())
+          break;
+        continue;
+      }
+
+      const Common::Size maxSize = myMaxSize;
+      const uInt32 generation = myGeneration;
+
+      lock.unlock();
+      const ImagePtr image = decode(fileName, maxSize);
+      lock.lock();
+
+      if(generation == myGeneration && myIndex.find(fileName) == myIndex.end())
+        store(image);
+      if(image->isValid() || myQuit)
+        break;
+    }
+    myPending.erase(fileNames.front());
+  }
+}
+
+#endif  // IMAGE_SUPPORT
@@ -0,0 +1,155 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2023 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifdef IMAGE_SUPPORT
+
+#ifndef IMAGE_CACHE_HXX
+#define IMAGE_CACHE_HXX
+
+class FrameBuffer;
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Rect.hxx"
+#include "bspf.hxx"
+
+/**
+  This class decodes the PNG and JPG images shown in the launcher by a pool
+  of background threads.  While decoding, the images are scaled down to the
+  largest size they are ever displayed at, and converted into the pixel
+  format of the framebuffer.  The results are kept in a memory bounded LRU
+  cache, so that they can be copied into a surface directly.
+
+  Images are requested by a list of alternative file names, of which the
+  first one which can be loaded is used.  Failed attempts are cached too.
+*/
+class ImageCache
+{
+  public:
+    struct Image {
+      string fileName;
+      string label;         // title or description from the meta data
+      string errorMsg;      // empty if the image was loaded
+      Common::Size size;
+      vector<uInt32> pixels;
+
+      bool isValid() const { return errorMsg.empty(); }
+    };
+    using ImagePtr = shared_ptr<const Image>;
+
+  public:
+    explicit ImageCache(const FrameBuffer& fb);
+    ~ImageCache();
+
+    /**
+      Set the size images are scaled down to.  If the size changes, all
+      cached images are discarded.
+
+      @param size  The maximum size of the images
+    */
+    void setMaxSize(const Common::Size& size);
+
+    /**
+      Get the first of the given alternative images which can be loaded.
+      Images not decoded yet are queued in front of all other requests.
+
+      @param fileNames  The file names of the alternative images
+      @param image      The image found, or the last failed attempt
+
+      @return  False if the images are still being decoded
+    */
+    bool get(const StringList& fileNames, ImagePtr& image);
+
+    /**
+      Queue the given alternative images for decoding, after all other
+      requests.
+
+      @param fileNames  The file names of the alternative images
+    */
+    void prefetch(const StringList& fileNames);
+
+    /**
+      Discard all requests still waiting for decoding, e.g. because another
+      ROM has been selected.  Cached images are kept.
+    */
+    void cancel();
+
+    /**
+      Discard all cached images, e.g. because new images may have been saved.
+    */
+    void clear();
+
+  private:
+    // Find the first alternative which is not cached yet, and queue it
+    // together with the remaining ones, must be called with the mutex locked
+    bool request(const StringList& fileNames, ImagePtr& image, bool prefetch);
+
+    // Add an image to the cache, must be called with the mutex locked
+    void store(const ImagePtr& image);
+
+    // The memory used by a cached image
+    static size_t imageSize(const Image& image);
+
+    // Load, scale and convert the image
+    ImagePtr decode(const string& fileName, const Common::Size& maxSize) const;
+
+    void threadMain();
+
+  private:
+    // Memory available for cached images
+    static constexpr size_t MAX_CACHE_SIZE = 32 * 1024 * 1024;
+
+    const FrameBuffer& myFB;
+
+    Common::Size myMaxSize;
+
+    // Cached images, the most recently used first
+    std::list<ImagePtr> myImages;
+    std::unordered_map<string, std::list<ImagePtr>::iterator> myIndex;
+    size_t myCacheSize{0};
+
+    // Incremented whenever cached images are discarded, so that images
+    // decoded for an outdated size are not stored
+    uInt32 myGeneration{0};
+
+    // Requests waiting for decoding, the most urgent first
+    std::deque<StringList> myQueue;
+    // First names of all queued and active requests
+    std::unordered_set<string> myPending;
+    vector<std::thread> myThreads;
+    std::mutex myMutex;
+    std::condition_variable myWakeup;
+    bool myQuit{false};
+
+  private:
+    // Following constructors and assignment operators not supported
+    ImageCache() = delete;
+    ImageCache(const ImageCache&) = delete;
+    ImageCache(ImageCache&&) = delete;
+    ImageCache& operator=(const ImageCache&) = delete;
+    ImageCache& operator=(ImageCache&&) = delete;
+};
+
+#endif
+
+#endif  // IMAGE_SUPPORT
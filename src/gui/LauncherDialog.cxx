@@ -34,7 +34,6 @@
 #include "GlobalPropsDialog.hxx"
 #include "StellaSettingsDialog.hxx"
 #include "WhatsNewDialog.hxx"
-#include "ProgressDialog.hxx"
 #include "MessageBox.hxx"
 #include "ToolTip.hxx"
 #include "TimerManager.hxx"
@@ -47,6 +46,7 @@
 #include "PropsSet.hxx"
 #include "RomImageWidget.hxx"
 #include "RomInfoWidget.hxx"
+#include "RomIndexer.hxx"
 #include "TIAConstants.hxx"
 #include "Settings.hxx"
 #include "Font.hxx"
@@ -299,9 +299,6 @@ int LauncherDialog::addRomWidgets(int ypos)
   myList = new LauncherFileListWidget(this, _font, xpos, ypos, listWidth, listHeight);
   myList->setEditable(false);
   myList->setListMode(FSNode::ListMode::All);
-  // since we cannot know how many files there are, use are really high value here
-  myList->progress().setRange(0, 50000, 5);
-  myList->progress().setMessage("        Filtering files" + ELLIPSIS + "        ");
   wid.push_back(myList);
 
   // Add ROM info area (if enabled)
@@ -412,10 +409,17 @@ const string& LauncherDialog::selectedRomMD5()
   if(myMD5List.size() > 500)
     myMD5List.clear();
 
-  // Lookup MD5, and if not present, cache it
+  // Lookup MD5, and if not present, get it from the ROM index (or the file,
+  // if it can't be indexed) and cache it
   const auto iter = myMD5List.find(currentNode().getPath());
   if(iter == myMD5List.end())
-    myMD5List[currentNode().getPath()] = OSystem::getROMMD5(currentNode());
+  {
+    RomIndexer::Entry entry;
+
+    myMD5List[currentNode().getPath()] =
+      instance().romIndexer().get(currentNode(), entry)
+        ? entry.md5 : OSystem::getROMMD5(currentNode());
+  }
 
   return myMD5List[currentNode().getPath()];
 }
@@ -533,13 +537,20 @@ void LauncherDialog::updateUI()
   // Only enable the navigation buttons if function is available
   myNavigationBar->updateUI();
 
-  // Indicate how many files were found
+  updateRomCount();
+  loadRomInfo();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::updateRomCount()
+{
+  // Indicate how many files were found (so far)
   ostringstream buf;
   buf << (myList->getList().size() - (currentDir().hasParent() ? 1 : 0))
     << (myShortCount ? " items" : " items found");
+  if(myList->isLoading())
+    buf << ELLIPSIS;
   myRomCount->setLabel(buf.str());
-
-  loadRomInfo();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -567,9 +578,12 @@ bool LauncherDialog::matchWithWildcardsIgnoreCase(
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void LauncherDialog::applyFiltering()
 {
+  // The filter is called from a background thread, so the pattern is
+  // copied instead of accessing the widget
+  const string pattern = myPattern ? myPattern->getText() : EmptyString;
+
   myList->setNameFilter(
-    [&](const FSNode& node) {
-      myList->incProgress();
+    [pattern](const FSNode& node) {
       if(!node.isDirectory())
       {
         // Only show valid ROMs
@@ -579,8 +593,8 @@ void LauncherDialog::applyFiltering()
           return false;
 
         // Skip over files that don't match the pattern in the 'pattern' textbox
-        if(myPattern && !myPattern->getText().empty() &&
-           !matchWithWildcardsIgnoreCase(node.getName(), myPattern->getText()))
+        if(!pattern.empty() &&
+           !matchWithWildcardsIgnoreCase(node.getName(), pattern))
           return false;
       }
       return true;
@@ -667,6 +681,10 @@ void LauncherDialog::loadRomInfo()
   myRomInfoTime = TimerManager::getTicks() / 1000 + myRomImageWidget->pendingLoadTime();
   myPendingRomInfo = true;
 
+  // Another ROM is selected, so the images still waiting for the previous
+  // selection and its neighbours are outdated
+  myRomImageWidget->cancelImages();
+
   const string& md5 = selectedRomMD5();
   if(!md5.empty())
   {
@@ -687,6 +705,32 @@ void LauncherDialog::loadRomInfo()
     myRomImageWidget->clearProperties();
     myRomInfoWidget->clearProperties();
   }
+  prefetchRomImages();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::prefetchRomImages()
+{
+  // Decode the images of the neighbouring ROMs, so that they can be shown
+  // immediately when scrolling
+  static constexpr int PREFETCH_RANGE = 2;
+  const int selected = myList->getSelected();
+
+  for(int dist = 1; dist <= PREFETCH_RANGE; ++dist)
+    for(const int item : {selected + dist, selected - dist})
+    {
+      const FSNode& node = myList->getNode(item);
+      RomIndexer::Entry entry;
+
+      // Only use ROMs already indexed, do not wait for others
+      if(instance().romIndexer().lookup(node, entry))
+      {
+        Properties properties;
+
+        instance().propSet().getMD5(entry.md5, properties);
+        myRomImageWidget->prefetchImages(node, properties);
+      }
+    }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1006,6 +1050,10 @@ void LauncherDialog::handleCommand(CommandSender* sender, int cmd,
       updateUI();
       break;
 
+    case FileListWidget::ListChanged:
+      updateRomCount();
+      break;
+
     case ListWidget::kLongButtonPressCmd:
       if(!currentNode().isDirectory() && Bankswitch::isValidRomName(currentNode()))
         openContextMenu();
@@ -1017,6 +1065,7 @@ void LauncherDialog::handleCommand(CommandSender* sender, int cmd,
     {
       const bool subDirs = instance().settings().getBool("launchersubdirs");
 
+      applyFiltering();
       myList->setIncludeSubDirs(subDirs);
       if(subDirs && cmd == EditableWidget::kChangedCmd)
       {
@@ -123,6 +123,7 @@ class LauncherDialog : public Dialog, CommandSender
     void loadConfig() override;
     void saveConfig() override;
     void updateUI();
+    void updateRomCount();
     void addTitleWidget(int& ypos);
     void addFilteringWidgets(int& ypos);
     void addPathWidgets(int& ypos);
@@ -149,6 +150,7 @@ class LauncherDialog : public Dialog, CommandSender
     void loadRom();
     void loadRomInfo();
     void loadPendingRomInfo();
+    void prefetchRomImages();
     void openSettings();
     void openGameProperties();
     void openContextMenu(int x = -1, int y = -1);
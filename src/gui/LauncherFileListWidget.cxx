@@ -18,7 +18,7 @@
 #include "Bankswitch.hxx"
 #include "FavoritesManager.hxx"
 #include "OSystem.hxx"
-#include "ProgressDialog.hxx"
+#include "RomIndexer.hxx"
 #include "Settings.hxx"
 
 #include "LauncherFileListWidget.hxx"
@@ -49,13 +49,13 @@ bool LauncherFileListWidget::isDirectory(const FSNode& node) const
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void LauncherFileListWidget::getChildren(const FSNode::CancelCheck& isCancelled)
+void LauncherFileListWidget::getChildren()
 {
   if(_node.exists() || !_node.hasParent())
   {
     myInVirtualDir = false;
     myVirtualDir = EmptyString;
-    FileListWidget::getChildren(isCancelled);
+    FileListWidget::getChildren();
   }
   else if(instance().settings().getBool("favorites"))
   {
@@ -103,6 +103,13 @@ void LauncherFileListWidget::getChildren(const FSNode::CancelCheck& isCancelled)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherFileListWidget::childrenLoaded()
+{
+  // Hash and detect the listed ROMs in the background
+  instance().romIndexer().index(_fileList);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void LauncherFileListWidget::addFolder(StringList& list, int& offset,
                                        string_view name, IconType icon)
@@ -143,7 +150,7 @@ void LauncherFileListWidget::extendLists(StringList& list)
   if(instance().settings().getBool("favorites") && _node.getPath() == myRomDir)
   {
     // Add virtual directories behind ".."
-    int offset = _fileList.begin()->getName() == ".." ? 1 : 0;
+    int offset = !_fileList.empty() && _fileList.begin()->getName() == ".." ? 1 : 0;
 
     if(!myFavorites->userList().empty())
       addFolder(list, offset, user_name, IconType::userdir);
@@ -232,7 +239,7 @@ void LauncherFileListWidget::userFavor(string_view path)
     pos++;
   }
   if(pos < _iconTypeList.size())
-    _iconTypeList[pos] = getIconType(path);
+    _iconTypeList[pos] = getIconType(_fileList[pos]);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -254,12 +261,11 @@ void LauncherFileListWidget::removeAllRecent()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-FileListWidget::IconType LauncherFileListWidget::getIconType(string_view path) const
+FileListWidget::IconType LauncherFileListWidget::getIconType(const FSNode& node) const
 {
-  if(!isUserFavorite(path))
-    return FileListWidget::getIconType(path);
+  if(!isUserFavorite(node.getPath()))
+    return FileListWidget::getIconType(node);
 
-  const FSNode node(path);
   if(node.isDirectory())
     return BSPF::endsWithIgnoreCase(node.getName(), ".zip")
       ? IconType::favzip : IconType::favdir;
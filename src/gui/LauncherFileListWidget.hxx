@@ -20,7 +20,6 @@
 
 class FavoritesManager;
 class FSNode;
-class ProgressDialog;
 class Settings;
 
 #include "FileListWidget.hxx"
@@ -71,11 +70,12 @@ class LauncherFileListWidget : public FileListWidget
 
   private:
     string startRomDir();
-    void getChildren(const FSNode::CancelCheck& isCancelled) override;
+    void getChildren() override;
+    void childrenLoaded() override;
     void userFavor(string_view path);
     void addFolder(StringList& list, int& offset, string_view name, IconType icon);
     void extendLists(StringList& list) override;
-    IconType getIconType(string_view path) const override;
+    IconType getIconType(const FSNode& node) const override;
     const Icon* getIcon(int i) const override;
     bool fullPathToolTip() const override { return myInVirtualDir; }
 
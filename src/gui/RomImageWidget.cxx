@@ -20,9 +20,7 @@
 #include "Dialog.hxx"
 #include "FBSurface.hxx"
 #include "Font.hxx"
-#include "JPGLibrary.hxx"
 #include "OSystem.hxx"
-#include "PNGLibrary.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
 #include "TimerManager.hxx"
@@ -42,6 +40,9 @@ RomImageWidget::RomImageWidget(GuiObject* boss, const GUI::Font& font,
 
   myZoomRect = Common::Rect(_w * 7 / 16, myImageHeight * 7 / 16,
                             _w * 9 / 16, myImageHeight * 9 / 16);
+#ifdef IMAGE_SUPPORT
+  myImageCache = make_unique<ImageCache>(instance().frameBuffer());
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -69,6 +70,9 @@ void RomImageWidget::clearProperties()
   myHaveProperties = mySurfaceIsValid = false;
   if(mySurface)
     mySurface->setVisible(false);
+#ifdef IMAGE_SUPPORT
+  myPendingImages.clear();
+#endif
 
   // Decide whether the information should be shown immediately
   if(instance().eventHandler().state() == EventHandlerState::LAUNCHER)
@@ -88,10 +92,30 @@ void RomImageWidget::reloadProperties(const FSNode& node)
   // The ROM may have changed since we were last in the browser, either
   // by saving a different image or through a change in video renderer,
   // so we reload the properties
+#ifdef IMAGE_SUPPORT
+  myImageCache->clear();
+#endif
   if(myHaveProperties)
     parseProperties(node);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomImageWidget::prefetchImages(const FSNode& node,
+                                    const Properties& properties)
+{
+#ifdef IMAGE_SUPPORT
+  myImageCache->prefetch(getImageNames(node, properties));
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomImageWidget::cancelImages()
+{
+#ifdef IMAGE_SUPPORT
+  myImageCache->cancel();
+#endif
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RomImageWidget::parseProperties(const FSNode& node, bool full)
 {
@@ -139,32 +163,24 @@ void RomImageWidget::parseProperties(const FSNode& node, bool full)
 
   myZoomMode = false;
 #ifdef IMAGE_SUPPORT
+  // Images are never shown larger than the launcher, even when zoomed
+  const uInt32 scaleDpi = fb.hidpiScaleFactor();
+  const Common::Size maxSize = fb.fullScreen()
+    ? fb.screenSize()
+    : dialog().surface().dstRect().size();
+
+  myImageCache->setMaxSize(Common::Size(maxSize.w / scaleDpi,
+                                        maxSize.h / scaleDpi));
   if(!full)
   {
     myImageIdx = 0;
     myImageList.clear();
     myLabel.clear();
+    myDefaultImage = false;
 
-    // Get a valid filename representing a snapshot file for this rom and load the snapshot
-    const string& path = instance().snapshotLoadDir().getPath();
-
-    // 1. Try to load first snapshot by property name
-    string fileName = path + myProperties.get(PropType::Cart_Name);
-    tryImageFormats(fileName);
-    if(!mySurfaceIsValid)
-    {
-      // 2. If none exists, try to load first snapshot by ROM file name
-      fileName = path + node.getName();
-      tryImageFormats(fileName);
-    }
-    if(mySurfaceIsValid)
-      myImageList.emplace_back(fileName);
-    else
-    {
-      // 3. If no ROM snapshots exist, try to load a default snapshot
-      fileName = path + "default_snapshot";
-      tryImageFormats(fileName);
-    }
+    // Load the first snapshot by property name or by ROM file name;
+    // the image is shown as soon as it has been decoded
+    loadImage(getImageNames(node, myProperties));
   }
   else
   {
@@ -179,9 +195,13 @@ void RomImageWidget::parseProperties(const FSNode& node, bool full)
     // The first file found before must not be the first file now, if files by
     // property *and* ROM name are found (TODO: fix that!)
     if(!myImageList.empty() && myImageList[0].getPath() != oldFileName)
-      loadImage(myImageList[0].getPath());
+      loadImage({myImageList[0].getPath()});
     else
       setDirty(); // update the counter display
+
+    // Prepare the image most likely shown next
+    if(myImageList.size() > 1)
+      myImageCache->prefetch({myImageList[1].getPath()});
   }
 #else
   mySurfaceIsValid = false;
@@ -205,11 +225,22 @@ bool RomImageWidget::changeImage(int direction)
 {
 #ifdef IMAGE_SUPPORT
   if(direction == -1 && myImageIdx)
-    return loadImage(myImageList[--myImageIdx].getPath());
+    --myImageIdx;
   else if(direction == 1 && myImageIdx + 1 < myImageList.size())
-    return loadImage(myImageList[++myImageIdx].getPath());
-#endif
+    ++myImageIdx;
+  else
+    return false;
+
+  loadImage({myImageList[myImageIdx].getPath()});
+
+  // Prepare the following image in the same direction
+  const size_t nextIdx = myImageIdx + direction;
+  if(nextIdx < myImageList.size())
+    myImageCache->prefetch({myImageList[nextIdx].getPath()});
+  return true;
+#else
   return false;
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -264,103 +295,85 @@ bool RomImageWidget::getImageList(const string& propName, const string& romName,
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool RomImageWidget::tryImageFormats(string& fileName)
+StringList RomImageWidget::getImageNames(const FSNode& node,
+                                         const Properties& properties) const
 {
-  if(loadImage(fileName + ".png"))
-  {
-    fileName += ".png";
-    return true;
-  }
-  if(loadImage(fileName + ".jpg"))
-  {
-    fileName += ".jpg";
-    return true;
-  }
-  return false;
+  const string& path = instance().snapshotLoadDir().getPath();
+  const string& propName = path + properties.get(PropType::Cart_Name);
+  const string& romName = path + node.getName();
+
+  // 1. Try to load first snapshot by property name
+  // 2. If none exists, try to load first snapshot by ROM file name
+  return { propName + ".png", propName + ".jpg",
+           romName + ".png", romName + ".jpg" };
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool RomImageWidget::loadImage(const string& fileName)
+void RomImageWidget::loadImage(const StringList& fileNames)
 {
-  mySurfaceErrorMsg.clear();
+  myPendingImages = fileNames;
+  updateImage();
+}
 
-  const string::size_type idx = fileName.find_last_of('.');
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomImageWidget::updateImage()
+{
+  ImageCache::ImagePtr image;
 
-  if(idx != string::npos && fileName.substr(idx + 1) == "png")
-    mySurfaceIsValid = loadPng(fileName);
-  else
-    mySurfaceIsValid = loadJpg(fileName);
+  // Keep showing the previous image until the new one has been decoded
+  if(!myImageCache->get(myPendingImages, image))
+    return;
+
+  myPendingImages.clear();
+
+  if(myImageList.empty() && !myDefaultImage)
+  {
+    if(image->isValid())
+      myImageList.emplace_back(image->fileName);
+    else
+    {
+      // 3. If no ROM snapshots exist, try to load a default snapshot
+      const string& path = instance().snapshotLoadDir().getPath();
+
+      myDefaultImage = true;
+      loadImage({ path + "default_snapshot.png", path + "default_snapshot.jpg" });
+      return;
+    }
+  }
+
+  mySurfaceErrorMsg = image->errorMsg;
+  mySurfaceIsValid = image->isValid();
+  myLabel = image->label;
 
   if(mySurfaceIsValid)
   {
+    // Copy the decoded image into the surface, enlarging it if necessary
+    const Common::Size& size = image->size;
+    if(size.w > mySurface->width() || size.h > mySurface->height())
+      mySurface->resize(size.w, size.h);
+
+    // The source dimensions are set here; the destination dimensions are
+    // set by zoomSurfaces()
+    mySurface->setSrcPos(0, 0);
+    mySurface->setSrcSize(size.w, size.h);
+
+    uInt32 *s_buf{nullptr}, s_pitch{0};
+    mySurface->basePtr(s_buf, s_pitch);
+    const uInt32* i_buf = image->pixels.data();
+
+    for(uInt32 irow = 0; irow < size.h; ++irow, i_buf += size.w, s_buf += s_pitch)
+      std::copy_n(i_buf, size.w, s_buf);
+
     mySrcRect = mySurface->srcRect();
     zoomSurfaces(false, true);
   }
 
-  if(mySurface)
-    mySurface->setVisible(mySurfaceIsValid);
+  mySurface->setVisible(mySurfaceIsValid);
+  myFrameSurface->setVisible(mySurfaceIsValid);
 
   if (!myZoomMode)
     myZoomTimer = 0;
   setDirty();
-  return mySurfaceIsValid;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool RomImageWidget::loadPng(const string& fileName)
-{
-  try
-  {
-    VariantList metaData;
-    instance().png().loadImage(fileName, *mySurface, metaData);
-
-    // Retrieve label for loaded image
-    myLabel.clear();
-    for(const auto& data: metaData)
-    {
-      if(data.first == "Title")
-      {
-        myLabel = data.second.toString();
-        break;
-      }
-      if(data.first == "Software"
-          && data.second.toString().find("Stella") == 0)
-        myLabel = "Snapshot"; // default for Stella snapshots with missing "Title" meta data
-    }
-    return true;
-  }
-  catch(const runtime_error& e)
-  {
-    mySurfaceErrorMsg = e.what();
-  }
-  return false;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool RomImageWidget::loadJpg(const string& fileName)
-{
-  try
-  {
-    VariantList metaData;
-    instance().jpg().loadImage(fileName, *mySurface, metaData);
-
-    // Retrieve label for loaded image
-    myLabel.clear();
-    for(const auto& data: metaData)
-    {
-      if(data.first == "ImageDescription")
-      {
-        myLabel = data.second.toString();
-        break;
-      }
-    }
-    return true;
-  }
-  catch(const runtime_error& e)
-  {
-    mySurfaceErrorMsg = e.what();
-  }
-  return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -525,6 +538,9 @@ void RomImageWidget::handleMouseMoved(int x, int y)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RomImageWidget::tick()
 {
+  if(!myPendingImages.empty())
+    updateImage();
+
   if(myMouseArea == Area::ZOOM || myZoomMode)
   {
     myZoomTimer += REQUEST_SPEED;
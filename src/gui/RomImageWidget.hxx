@@ -22,6 +22,9 @@ class FBSurface;
 class Properties;
 
 #include "Widget.hxx"
+#ifdef IMAGE_SUPPORT
+  #include "ImageCache.hxx"
+#endif
 
 class RomImageWidget : public Widget
 {
@@ -39,6 +42,10 @@ class RomImageWidget : public Widget
                        bool full = true);
     void clearProperties();
     void reloadProperties(const FSNode& node);
+    // Decode the images of another ROM in advance, e.g. of a neighbouring ROM
+    void prefetchImages(const FSNode& node, const Properties& properties);
+    // Discard the images still waiting to be decoded, e.g. for another ROM
+    void cancelImages();
     bool changeImage(int direction = 1);
     // Toggle zoom via keyboard
     void toggleImageZoom();
@@ -60,10 +67,10 @@ class RomImageWidget : public Widget
   #ifdef IMAGE_SUPPORT
     bool getImageList(const string& propName, const string& romName,
                       const string& oldFileName);
-    bool tryImageFormats(string& fileName);
-    bool loadImage(const string& fileName);
-    bool loadPng(const string& fileName);
-    bool loadJpg(const string& fileName);
+    StringList getImageNames(const FSNode& node,
+                             const Properties& properties) const;
+    void loadImage(const StringList& fileNames);
+    void updateImage();
 
     void zoomSurfaces(bool zoomed, bool force = false);
     void positionSurfaces();
@@ -149,6 +156,17 @@ class RomImageWidget : public Widget
     // Maximum load time, for adapting pending loads delay
     uInt64 myMaxLoadTime{0};
 
+  #ifdef IMAGE_SUPPORT
+    // Decodes the images in the background and caches them
+    unique_ptr<ImageCache> myImageCache;
+
+    // Alternative file names of the image waited for
+    StringList myPendingImages;
+
+    // Indicates that the default snapshot is loaded, since the ROM has none
+    bool myDefaultImage{false};
+  #endif
+
   private:
     // Following constructors and assignment operators not supported
     RomImageWidget() = delete;
@@ -25,6 +25,7 @@
 #include "CartDetector.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "RomIndexer.hxx"
 #include "RomInfoWidget.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -122,10 +123,13 @@ void RomInfoWidget::parseProperties(const FSNode& node, bool full)
     try
     {
       ByteBuffer image;
-      string md5;
+      RomIndexer::Entry entry;
+      const bool isFile = node.exists() && !node.isDirectory();
+      // The indexed MD5 avoids hashing the image again; files which are not
+      // indexed (e.g. without a ROM extension) are hashed while opened
+      const bool indexed = isFile && instance().romIndexer().get(node, entry);
 
-      if(node.exists() && !node.isDirectory() &&
-        (image = instance().openROM(node, md5, size)) != nullptr)
+      if(isFile && (image = instance().openROM(node, entry.md5, size)) != nullptr)
       {
         Logger::debug(myProperties.get(PropType::Cart_Name) + ":");
         left = ControllerDetector::detectName(image, size, leftType,
@@ -135,9 +139,11 @@ void RomInfoWidget::parseProperties(const FSNode& node, bool full)
           !swappedPorts ? Controller::Jack::Right : Controller::Jack::Left,
             instance().settings());
         if(bsDetected == "AUTO")
-          bsDetected = Bankswitch::typeToName(CartDetector::autodetectType(image, size));
+          bsDetected = indexed ? entry.type
+            : Bankswitch::typeToName(CartDetector::autodetectType(image, size));
 
-        isPlusCart = CartDetector::isProbablyPlusROM(image, size);
+        isPlusCart = indexed ? entry.isPlusROM
+          : CartDetector::isProbablyPlusROM(image, size);
       }
     }
     catch(const runtime_error&)
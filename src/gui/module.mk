@@ -24,6 +24,7 @@ MODULE_OBJS := \
         src/gui/HelpDialog.o \
         src/gui/HighScoresDialog.o \
         src/gui/HighScoresMenu.o \
+        src/gui/ImageCache.o \
         src/gui/InputDialog.o \
         src/gui/InputTextDialog.o \
         src/gui/JoystickDialog.o \
@@ -77,6 +77,11 @@ class OSystemLIBRETRO : public OSystem
       return make_shared<CompositeKeyValueRepositoryNoop>();
     }
 
+    shared_ptr<KeyValueRepositoryAtomic>
+    getRomIndexRepository() override {
+      return make_shared<KeyValueRepositoryNoop>();
+    }
+
   protected:
     void initPersistence(FSNode& basedir) override { }
     string describePresistence() override { return "none"; }
@@ -187,8 +187,9 @@ void StellaLIBRETRO::updateAudio()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool StellaLIBRETRO::loadState(const void* data, size_t size)
 {
-  Serializer state;
+  Serializer& state = state_serializer;
 
+  state.reset();
   state.putByteArray(reinterpret_cast<const uInt8*>(data), size);
 
   if(!myOSystem->state().loadState(state))
@@ -201,23 +202,25 @@ bool StellaLIBRETRO::loadState(const void* data, size_t size)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool StellaLIBRETRO::saveState(void* data, size_t size) const
 {
-  Serializer state;
+  Serializer& state = state_serializer;
 
+  state.reset();
   if (!myOSystem->state().saveState(state))
     return false;
 
   if (state.size() > size)
     return false;
 
-  state.getByteArray(reinterpret_cast<uInt8*>(data), state.size());
+  std::copy_n(state.data(), state.size(), static_cast<uInt8*>(data));
   return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 size_t StellaLIBRETRO::getStateSize() const
 {
-  Serializer state;
+  Serializer& state = state_serializer;
 
+  state.reset();
   if (!myOSystem->state().saveState(state))
     return 0;
 
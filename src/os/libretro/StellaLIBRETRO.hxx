@@ -30,6 +30,7 @@
 #include "M6532.hxx"
 #include "Paddles.hxx"
 #include "PaletteHandler.hxx"
+#include "Serializer.hxx"
 #include "System.hxx"
 #include "TIA.hxx"
 #include "TIASurface.hxx"
@@ -185,6 +186,9 @@ class StellaLIBRETRO
 
     uInt8 system_ram[128];
 
+    // Reused by the (frequently called) state functions, to keep its buffer
+    mutable Serializer state_serializer;
+
     // (31440 rate / 50 Hz) * 16-bit stereo * 1.25x padding
     static constexpr uInt32 audio_buffer_max = (31440 / 50 * 4 * 5) / 4;
 
@@ -96,6 +96,13 @@ size_t FSNodeWINDOWS::getSize() const
   return _size;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt64 FSNodeWINDOWS::getModifiedTime() const
+{
+  struct _stat st;
+  return _stat(_path.c_str(), &st) == 0 ? static_cast<uInt64>(st.st_mtime) : 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 AbstractFSNodePtr FSNodeWINDOWS::getParent() const
 {
@@ -65,6 +65,7 @@ class FSNodeWINDOWS : public AbstractFSNode
     bool rename(string_view newfile) override;
 
     size_t getSize() const override;
+    uInt64 getModifiedTime() const override;
     bool hasParent() const override { return !_isPseudoRoot; }
     AbstractFSNodePtr getParent() const override;
     bool getChildren(AbstractFSList& list, ListMode mode) const override;
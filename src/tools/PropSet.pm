@@ -171,6 +171,22 @@ sub num_prop_types {
   return keys( %prop_type );
 }
 
+# Get the values of a properties set, with default values replaced by
+# empty strings (these are filled in by Stella at runtime)
+sub build_prop_values {
+  my @array = @_;
+  my @values = ();
+  for (my $i = 0; $i < @array; $i++) {
+    if($prop_defaults[$i] ne $array[$i]) {
+      push(@values, $array[$i]);
+    } else {
+      push(@values, "");
+    }
+  }
+
+  return @values;
+}
+
 # Convert a properties set into a C++ compatible string
 sub build_prop_string {
   my @array = @_;
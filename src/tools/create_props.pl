@@ -66,9 +66,113 @@ print OUTFILE "  located in the src/tools directory.  All properties changes\n";
 print OUTFILE "  should be made in stella.pro, and then this file should be\n";
 print OUTFILE "  regenerated and the application recompiled.\n";
 print OUTFILE "*/\n";
+# Collect the MD5 keys and the (deduplicated) values of all items, in
+# order of md5sum
+my @md5s = sort keys %propset;
+my @keys = ();
+my @rows = ();
+my @values = ( "" );
+my %valueidx = ( "" => 0 );
+for my $md5 ( @md5s )
+{
+  if ($md5 !~ /^[0-9a-fA-F]{32}$/) {
+    die "ERROR: invalid md5 = \'$md5\'\n";
+  }
+  push(@keys, [ map { hex(substr($md5, $_ * 8, 8)) } 0..3 ]);
+
+  my @props = PropSet::build_prop_values(@{ $propset{$md5} });
+  $props[0] = "";  # the md5 is stored in DefPropsMD5
+  my @row = ();
+  for my $value ( @props )
+  {
+    if (!defined $valueidx{$value}) {
+      $valueidx{$value} = scalar @values;
+      push(@values, $value);
+    }
+    push(@row, $valueidx{$value});
+  }
+  push(@rows, [ @row ]);
+}
+my $valuesize = scalar @values;
+if ($valuesize > 65535) {
+  die "ERROR: too many distinct property values ($valuesize)\n";
+}
+
+# Create a perfect hash of the MD5 keys ('hash and displace')
+# Word 0 selects a bucket, and the bucket's seed then selects a slot for
+# each of its keys from words 1 and 2; the number of slots is prime, so
+# that every seed value results in a different slot
+my $numbuckets = int(($setsize + 1) / 2);
+my $numslots = $setsize;
+$numslots++ while (!is_prime($numslots));
+
+my @buckets = ();
+for (my $i = 0; $i < $setsize; $i++) {
+  push(@{ $buckets[$keys[$i][0] % $numbuckets] }, $i);
+}
+my @seeds = (0) x $numbuckets;
+my @slots = (65535) x $numslots;
+for my $b ( sort { scalar(@{ $buckets[$b] // [] }) <=> scalar(@{ $buckets[$a] // [] }) || $a <=> $b } 0..$numbuckets-1 )
+{
+  my @items = @{ $buckets[$b] // [] };
+  last if (!@items);
+
+  my $found = 0;
+  for (my $seed = 0; $seed < 65535 && !$found; $seed++)
+  {
+    my %used = ();
+    my @pos = map { hash_slot($keys[$_], $seed) } @items;
+    $found = 1;
+    for my $p ( @pos ) {
+      if ($slots[$p] != 65535 || $used{$p}++) {
+        $found = 0;
+        last;
+      }
+    }
+    if ($found) {
+      $seeds[$b] = $seed;
+      for (my $k = 0; $k < @items; $k++) {
+        $slots[$pos[$k]] = $items[$k];
+      }
+    }
+  }
+  if (!$found) {
+    die "ERROR: couldn't create perfect hash for bucket $b\n";
+  }
+}
+
 print OUTFILE "\nstatic constexpr uInt32 DEF_PROPS_SIZE = " . $setsize . ";";
+print OUTFILE "\nstatic constexpr uInt32 DEF_PROPS_VALUES_SIZE = " . $valuesize . ";";
+print OUTFILE "\nstatic constexpr uInt32 DEF_PROPS_HASH_BUCKETS = " . $numbuckets . ";";
+print OUTFILE "\nstatic constexpr uInt32 DEF_PROPS_HASH_SLOTS = " . $numslots . ";";
 print OUTFILE "\n\n";
 print OUTFILE "/**\n";
+print OUTFILE "  The md5sum of each item as four 32-bit words (most significant first),\n";
+print OUTFILE "  in the same order as the items in 'DefProps'.\n";
+print OUTFILE "*/\n";
+print OUTFILE "static constexpr BSPF::array2D<uInt32, DEF_PROPS_SIZE, 4> DefPropsMD5 = {{\n";
+for (my $i = 0; $i < $setsize; $i++)
+{
+  printf OUTFILE "  { 0x%08x, 0x%08x, 0x%08x, 0x%08x }", @{ $keys[$i] };
+  print OUTFILE ($i+1 < $setsize ? ",\n" : "\n");
+}
+print OUTFILE "}};\n";
+print OUTFILE "\n";
+print OUTFILE "/**\n";
+print OUTFILE "  Perfect hash of the md5sums: word 0 selects a seed from 'DefPropsHashSeed',\n";
+print OUTFILE "  which together with words 1 and 2 selects a slot in 'DefPropsHashSlot'\n";
+print OUTFILE "  (see 'PropertiesSet::findDefault').  Each slot contains the index of\n";
+print OUTFILE "  the item, or 0xFFFF if it is unused.\n";
+print OUTFILE "*/\n";
+print OUTFILE "static constexpr std::array<uInt16, DEF_PROPS_HASH_BUCKETS> DefPropsHashSeed = {{\n";
+print_numbers(@seeds);
+print OUTFILE "}};\n";
+print OUTFILE "\n";
+print OUTFILE "static constexpr std::array<uInt16, DEF_PROPS_HASH_SLOTS> DefPropsHashSlot = {{\n";
+print_numbers(@slots);
+print OUTFILE "}};\n";
+print OUTFILE "\n";
+print OUTFILE "/**\n";
 # FIXME: Remove this once clang properly supports constexpr string_view
 print OUTFILE "  FIXME\n";
 print OUTFILE "  We need to use 'const char*' instead of 'string_view' here,\n";
@@ -76,22 +180,25 @@ print OUTFILE "  since clang is not optimized to create so many constexpr\n";
 print OUTFILE "  'string_view's.  It *can* do it by using\n";
 print OUTFILE "  -fconstexpr-steps=2710000, which increases binary size.\n";
 print OUTFILE "*/\n";
+print OUTFILE "static constexpr std::array<const char*, DEF_PROPS_VALUES_SIZE> DefPropsValues = {{\n";
+for (my $i = 0; $i < $valuesize; $i++)
+{
+  print OUTFILE "  \"$values[$i]\"";
+  print OUTFILE ($i+1 < $valuesize ? ",\n" : "\n");
+}
+print OUTFILE "}};\n";
+print OUTFILE "\n";
+print OUTFILE "/**\n";
+print OUTFILE "  The properties of each item, as indices into 'DefPropsValues'.\n";
+print OUTFILE "  Index 0 is the empty string, which means the default value is used.\n";
+print OUTFILE "*/\n";
 #######################################################################
-print OUTFILE "static constexpr BSPF::array2D<const char*, DEF_PROPS_SIZE, " . $typesize . "> DefProps = {{\n";
-
-# Walk the hash map and print each item in order of md5sum
-my $idx = 0;
-for my $key ( sort keys %propset )
+print OUTFILE "static constexpr BSPF::array2D<uInt16, DEF_PROPS_SIZE, " . $typesize . "> DefProps = {{\n";
+for (my $i = 0; $i < $setsize; $i++)
 {
-  print OUTFILE PropSet::build_prop_string(@{ $propset{$key} });
-
-  if ($idx+1 < $setsize) {
-    print OUTFILE ",";
-  }
-  print OUTFILE "\n";
-  $idx++;
+  print OUTFILE "  { " . join(", ", @{ $rows[$i] }) . " }";
+  print OUTFILE ($i+1 < $setsize ? ",\n" : "\n");
 }
-
 print OUTFILE "}};\n";
 print OUTFILE "\n";
 print OUTFILE "#endif\n";
@@ -99,6 +206,32 @@ print OUTFILE "#endif\n";
 close(OUTFILE);
 
 
+sub hash_slot {
+  my ($key, $seed) = @_;
+  return ($key->[1] + $seed * ($key->[2] % ($numslots - 1) + 1)) % $numslots;
+}
+
+sub is_prime {
+  my $n = shift;
+  return 0 if ($n < 2);
+  for (my $d = 2; $d * $d <= $n; $d++) {
+    return 0 if ($n % $d == 0);
+  }
+  return 1;
+}
+
+sub print_numbers {
+  my @numbers = @_;
+  for (my $i = 0; $i < @numbers; $i += 16)
+  {
+    my $last = $i + 15 < $#numbers ? $i + 15 : $#numbers;
+    print OUTFILE "  " . join(", ", @numbers[$i..$last]);
+    print OUTFILE ($last < $#numbers ? ",
+" : "
+");
+  }
+}
+
 sub usage {
   print "create_props.pl <INPUT properties file> <OUTPUT C++ header>\n";
   print "\n";
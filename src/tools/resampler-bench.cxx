@@ -0,0 +1,176 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2023 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+/*
+  Standalone benchmark for the audio resamplers. For each combination of
+  resampler, input and output format, a stream of pseudo random TIA samples
+  is resampled and the throughput in output samples per second is reported,
+  together with a checksum of the first output fragments (which allows
+  verifying that two implementations produce identical results).
+
+  Build with 'make resampler-bench', run as
+
+    resampler-bench [seconds per combination]
+*/
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+
+#include "bspf.hxx"
+#include "Logger.hxx"
+#include "audio/SimpleResampler.hxx"
+#include "audio/LanczosResampler.hxx"
+
+using namespace std::chrono;
+
+namespace {
+
+  struct Source {
+    const char* name;
+    uInt32 sampleRate;
+    uInt32 fragmentSize;
+  };
+
+  struct Sink {
+    uInt32 sampleRate;
+    uInt32 fragmentSize;
+  };
+
+  // The TIA sample rates and fragment sizes for NTSC and PAL at normal speed
+  constexpr std::array<Source, 2> SOURCES = {{
+    { "NTSC", 31440, 262 },
+    { "PAL", 31200, 312 }
+  }};
+
+  constexpr std::array<Sink, 3> SINKS = {{
+    { 44100, 1024 },
+    { 48000, 1024 },
+    { 96000, 2048 }
+  }};
+
+  constexpr uInt32 FRAGMENT_POOL_SIZE = 16;
+
+  // The checksum covers this many output fragments, independent of timing
+  constexpr uInt64 CHECKSUM_FRAGMENTS = 256;
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  unique_ptr<Resampler> createResampler(
+    uInt32 quality, Resampler::Format formatFrom, Resampler::Format formatTo,
+    const Resampler::NextFragmentCallback& callback)
+  {
+    switch(quality)
+    {
+      case 1:
+        return make_unique<SimpleResampler>(formatFrom, formatTo, callback);
+
+      default:
+        return make_unique<LanczosResampler>(formatFrom, formatTo, callback, quality);
+    }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void runBenchmark(uInt32 quality, const Source& source, bool stereoIn,
+                    const Sink& sink, bool stereoOut, double seconds)
+  {
+    const uInt32 channelsIn = stereoIn ? 2 : 1;
+    const uInt32 channelsOut = stereoOut ? 2 : 1;
+
+    // A pool of fragments with deterministic pseudo random content
+    vector<Int16> samples(static_cast<size_t>(source.fragmentSize) *
+                          channelsIn * FRAGMENT_POOL_SIZE);
+    uInt32 seed = 0x2600;
+    for(auto& sample: samples)
+    {
+      seed = seed * 1664525 + 1013904223;
+      sample = static_cast<Int16>((seed >> 16) & 0x7fff);
+    }
+
+    uInt32 nextFragment = 0;
+    const Resampler::NextFragmentCallback callback = [&] () -> Int16* {
+      Int16* fragment = samples.data() +
+        static_cast<size_t>(source.fragmentSize) * channelsIn * nextFragment;
+      nextFragment = (nextFragment + 1) % FRAGMENT_POOL_SIZE;
+
+      return fragment;
+    };
+
+    const unique_ptr<Resampler> resampler = createResampler(quality,
+      Resampler::Format(source.sampleRate, source.fragmentSize, stereoIn),
+      Resampler::Format(sink.sampleRate, sink.fragmentSize, stereoOut),
+      callback
+    );
+
+    const uInt32 length = sink.fragmentSize * channelsOut;
+    vector<float> fragment(length);
+    uInt64 fragments = 0;
+    uInt32 checksum = 0x811c9dc5;
+
+    const auto start = high_resolution_clock::now();
+    duration<double> elapsed{0};
+
+    do {
+      // Check the clock only every few fragments in order to keep its overhead low
+      for(uInt64 i = 0; i < 64; ++i)
+      {
+        resampler->fillFragment(fragment.data(), length);
+        if(fragments + i >= CHECKSUM_FRAGMENTS) continue;
+
+        for(const float value: fragment)
+        {
+          uInt32 bits = 0;
+          std::memcpy(&bits, &value, sizeof(bits));
+          checksum = (checksum ^ bits) * 0x01000193;
+        }
+      }
+      fragments += 64;
+      elapsed = high_resolution_clock::now() - start;
+    } while(elapsed.count() < seconds);
+
+    const double samplesPerSecond =
+      static_cast<double>(fragments * sink.fragmentSize) / elapsed.count();
+
+    cout << std::setw(9) << (quality == 1 ? "simple" : quality == 2 ? "lanczos2" : "lanczos3")
+         << std::setw(6) << source.name
+         << std::setw(8) << (stereoIn ? "stereo" : "mono")
+         << std::setw(7) << sink.sampleRate
+         << std::setw(8) << (stereoOut ? "stereo" : "mono")
+         << std::setw(14) << std::fixed << std::setprecision(0) << samplesPerSecond
+         << "   " << std::hex << std::setw(8) << std::setfill('0') << checksum
+         << std::dec << std::setfill(' ') << endl;
+  }
+
+} // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int main(int ac, char* av[])
+{
+  const double seconds = ac > 1 ? std::max(atof(av[1]), 0.01) : 0.5;
+
+  Logger::instance().setLogParameters(Logger::Level::MIN, false);
+
+  cout << "resampler  tia   input    rate  output     samples/s   checksum" << endl;
+
+  for(uInt32 quality = 1; quality <= 3; ++quality)
+    for(const auto& source: SOURCES)
+      for(const bool stereoIn: { false, true })
+        for(const auto& sink: SINKS)
+          for(const bool stereoOut: { false, true })
+            runBenchmark(quality, source, stereoIn, sink, stereoOut, seconds);
+
+  return 0;
+}